@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class AudioPlayerFactory extends Deletable {
+        /** @param playerFactory Creates a viewhost audio player for an event listener */
+        public static create(playerFactory : (eventListener : any) => any) : AudioPlayerFactory;
+        public tick() : void;
+        public destroy() : void;
+    }
+}
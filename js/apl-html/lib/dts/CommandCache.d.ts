@@ -0,0 +1,22 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export interface CommandCacheStats {
+        hits: number;
+        misses: number;
+        entries: number;
+        templates: number;
+        pooledBuffers: number;
+    }
+
+    export class CommandCache {
+        public static registerTemplate(name : string, commands : string) : boolean;
+        public static unregisterTemplate(name : string) : boolean;
+        public static clear() : void;
+        public static setCapacity(capacity : number) : void;
+        public static getStats() : CommandCacheStats;
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+ declare namespace APL {
+    export interface ComponentSnapshot {
+        count: number;
+        /** Per node: parent index, depth, type, displayed child count, first child index */
+        nodes: Int32Array;
+        /** Null for node 0, the component the snapshot was taken of */
+        components: Array<Component | null>;
+        uniqueIds: string[];
+        ids: string[];
+        props: Array<{[key : number] : any}>;
+    }
+
+    export class Component extends Deletable {
+        public getCalculated() : {[key : number] : any};
+        public getCalculatedByKey<T>(key : number) : T;
+        public getCalculatedNumber(key : number) : number;
+        public getCalculatedColor(key : number) : number;
+        public getDirtyProps() : {[key : number] : any};
+        public getType() : number;
+        public getUniqueId() : string;
+        public getId() : string;
+        public getParent() : Component;
+        public isFocusable() : boolean;
+        public update(type : number, value : number) : void;
+        public updateEditText(type : number, value : string) : void;
+        public pressed() : void;
+        public updateScrollPosition(position : number);
+        public updatePagerPosition(position : number);
+        public updateGraphic(json : string);
+        public getChildCount() : number;
+        public getChildAt(index : number) : Component;
+        public getDisplayedChildCount() : number;
+        public getDisplayedChildAt(index : number) : Component;
+        public getDisplayedChildId(displayIndex : number) : string;
+        public appendChild(child : Component) : boolean;
+        public insertChild(child : Component, index : number) : boolean;
+        public remove() : boolean;
+        public inflateChild(data : string, index : number) : Component;
+        public getBoundsInParent(ancestor : Component) : APL.Rect;
+        public getGlobalBounds() : APL.Rect;
+        public ensureLayout() : Promise<void> | void;
+        public isCharacterValid(c : string) : Promise<boolean>;
+        public provenance() : string;
+        public getMediaPlayer() : APL.MediaPlayer;
+        public snapshotSubtree(maxDepth : number) : ComponentSnapshot;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class ImportRef {
+        public version(): string;
+        public name(): string;
+        public domain(): string;
+        public toString(): string;
+    }
+
+    export class ImportRequest {
+        public isValid(): boolean;
+        public reference(): ImportRef;
+        public source(): string;
+    }
+
+    export interface PackageImport {
+        name: string;
+        version: string;
+        source?: string;
+        domain?: string;
+    }
+
+    export interface PrefetchImport extends PackageImport {
+        /** The package cache key */
+        reference: string;
+    }
+
+    export class Content extends Deletable {
+        public static create(document: string, session: Session): Content;
+        public static createWithConfig(document: string, session: Session,
+                                       metrics: Metrics, config: RootConfig): Content;
+        public static createFromBuffer(document: number, length: number, session: Session): Content | null;
+        public static createFromBufferWithConfig(document: number, length: number, session: Session,
+                                                 metrics: Metrics, config: RootConfig): Content | null;
+        public static createFromCompressedBuffer(document: number, length: number, session: Session): Content | null;
+        public static createFromCompressedBufferWithConfig(document: number, length: number, session: Session,
+                                                           metrics: Metrics, config: RootConfig): Content | null;
+        public refresh(metrics: Metrics, config: RootConfig): void;
+        public load(onSuccess: () => void, onFailure: () => void): void;
+        public getRequestedPackages(): Set<ImportRequest>;
+        public getPrefetchImports(): PrefetchImport[];
+        public addPackage(request: ImportRequest, data: string): void;
+        public isError(): boolean;
+        public isReady(): boolean;
+        public isWaiting(): boolean;
+        public addData(name: string, data: string): void;
+        /** The *FromBuffer methods return true if the data parsed, core is told of any failure */
+        public addDataFromBuffer(name: string, data: number, length: number): boolean;
+        public addPackageFromBuffer(request: ImportRequest, data: number, length: number): boolean;
+        public addDataFromCompressedBuffer(name: string, data: number, length: number): boolean;
+        public addPackageFromCompressedBuffer(request: ImportRequest, data: number, length: number): boolean;
+        /**
+         * Add the data sources of another content, sharing their parsed documents. Parameters without
+         * data are resolved from the payload members. Returns the names of the data sources added.
+         */
+        public copyData(other: Content): string[];
+        public getAPLVersion(): string;
+        public getExtensionRequests(): Set<string>;
+        public getExtensionSettings(uri: string): object;
+        public getParameterAt(index: number): string;
+        public getParameterCount(): number;
+    }
+}
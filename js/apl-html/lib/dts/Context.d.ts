@@ -0,0 +1,275 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+
+    export interface DataSourceUpdate {
+        payload: string;
+        type?: string;
+    }
+
+    export interface TextMeasureResult {
+        width: number;
+        height: number;
+        baseline: number;
+        lineCount: number;
+        plainText: string;
+        laidOutText: string;
+        isTruncated: boolean;
+        textsByLine: string[];
+        rectsByLine: number[][];
+    }
+
+    export interface TextMeasureRequest {
+        component: APL.Component;
+        width: number;
+        widthMode: number;
+        height: number;
+        heightMode: number;
+    }
+
+    export interface TextMeasure {
+        onMeasure(component: APL.Component,
+                  width: number,
+                  widthMode: number,
+                  height: number,
+                  heightMode: number): TextMeasureResult;
+        onMeasureBatch?(requests: TextMeasureRequest[]): TextMeasureResult[];
+    }
+
+    export interface IBackground {
+        color: string;
+        gradient: APL.Image.IGradient | null;
+    }
+
+    export interface FrameDelta {
+        buffer: Float64Array;
+        strings: Uint8Array;
+        objects: any[];
+    }
+
+    export interface FrameEvents {
+        eventCount: number;
+        /** Decoded events when the context was created with the decodeEvents option */
+        events: Event[] | DecodedEvent[];
+        decodedEvents: boolean;
+    }
+
+    export interface FrameResult {
+        ready: boolean;
+        dirtyCount: number;
+        delta: FrameDelta | null;
+        screenLock: boolean;
+        hasPendingErrors: boolean;
+        errors: object[] | null;
+        /** Handles of destroyed components found this frame, null when there are none */
+        releasedHandles: Int32Array | null;
+        /** True when the next frame has work regardless of nextTime */
+        pendingWork: boolean;
+        nextTime: number;
+    }
+
+    export interface TextMeasurementCacheStats {
+        hits: number;
+        misses: number;
+        evictions: number;
+        entries: number;
+        bytes: number;
+        byteBudget: number;
+    }
+
+    export type DisplayMetricKind = 'counter' | 'timer';
+
+    export interface DisplayMetric {
+        kind: DisplayMetricKind;
+        name: string;
+        value: number;
+    }
+
+    export class Context extends Deletable {
+        public static create(options: any,
+                             text: TextMeasure,
+                             metrics?: APL.Metrics,
+                             content?: APL.Content,
+                             config?: APL.RootConfig,
+                             scalingOptions?: any): Context;
+
+        /** Release the binding state of the context, call before delete */
+        public destroy(): void;
+
+        public topComponent(): APL.Component;
+
+        public topDocument(): APL.DocumentContext;
+
+        public getComponentHandle(component: APL.Component): number;
+
+        public getTopComponentHandle(): number;
+
+        /** Null for a handle whose component was released, even if its slot holds another one now */
+        public getComponentByHandle(handle: number): APL.Component | null;
+
+        public getParentHandle(handle: number): number;
+
+        public getChildHandles(handle: number): Int32Array;
+
+        public getDisplayedChildHandles(handle: number): Int32Array;
+
+        public getComponentTypes(handles: Int32Array | number[]): Int32Array;
+
+        public getGlobalBoundsForHandles(handles: Int32Array | number[]): Float64Array;
+
+        public getCalculatedForHandles(handles: Int32Array | number[], key: number): any[];
+
+        public collectReleasedHandles(): Int32Array;
+
+        public getBackground(): APL.IBackground;
+
+        public setBackground(background: APL.IBackground): void;
+
+        public getDocumentState(): Promise<string>;
+
+        public getDataSourceContext(): Promise<string>;
+
+        public getVisualContext(): Promise<string>;
+
+        /**
+         * @param mode 0 for a JSON string, 1 for a Uint8Array view of UTF-8 JSON in wasm memory,
+         *             2 for an object
+         */
+        public getDocumentStateAs(mode: number): string | Uint8Array | object;
+
+        public getDataSourceContextAs(mode: number): string | Uint8Array | object;
+
+        public getVisualContextAs(mode: number): string | Uint8Array | object;
+
+        public clearPending(): void;
+
+        public isDirty(): boolean;
+
+        public clearDirty(): void;
+
+        public getDirty(): string[];
+
+        public collectFrameDelta(): APL.FrameDelta;
+
+        public getPendingErrors(): object[];
+
+        public executeCommands(commands: string): Action;
+
+        public executeCommandTemplate(name: string, args?: {[name: string]: any}): Action | null;
+
+        public invokeExtensionEventHandler(uri: string, name: string, data: string, fastMode: boolean): Action;
+
+        public scrollToRectInComponent(component: APL.Component,
+                                       x: number,
+                                       y: number,
+                                       width: number,
+                                       height: number,
+                                       align: number): void;
+
+        public handleKeyboard(keyType: number, keyboard: APL.Keyboard): Promise<boolean>;
+
+        /**
+         * @param codeId KeyTable id of the key code
+         * @param keyId KeyTable id of the key
+         * @param modifiers Bitmask of repeat (1), alt (2), ctrl (4), meta (8) and shift (16)
+         */
+        public handleKeyboardCode(keyType: number, codeId: number, keyId: number, modifiers: number): boolean;
+
+        /**
+         * @param events Packed (keyType, codeId, keyId, modifiers) tuples
+         * @returns The consumed flag of every event
+         */
+        public handleKeyboardSequence(events: Int32Array): Uint8Array;
+
+        public cancelExecution();
+
+        public hasEvent(): boolean;
+
+        public popEvent(): Event;
+
+        /**
+         * @returns Every pending event, with its values already converted
+         */
+        public drainEvents(): DecodedEvent[];
+
+        public resolveEvent(token: number): void;
+
+        public resolveEventWithArg(token: number, arg: number): void;
+
+        public resolveEventWithRect(token: number, x: number, y: number, width: number, height: number): void;
+
+        public addEventTerminateCallback(token: number, callback: () => void): void;
+
+        public screenLock(): boolean;
+
+        public currentTime(): number;
+
+        public nextTime(): number;
+
+        public getViewportPixelSize(): object;
+
+        public getViewportWidth(): number;
+
+        public getViewportHeight(): number;
+
+        public getScaleFactor(): number;
+
+        public updateTime(currentTime: number, utcTime: number): number;
+
+        public setLocalTimeAdjustment(offset: number): void;
+
+        public tick(currentTime: number, utcTime: number, offset: number): FrameEvents;
+
+        /** Collect the frame started by tick, once its events have been processed */
+        public collectFrame(): FrameResult;
+
+        public hasPendingWork(): boolean;
+
+        public updateCursorPosition(x: number, y: number): void;
+
+        public handlePointerEvent(pointerEventType: number,
+                                  x: number,
+                                  y: number,
+                                  pointerId: number,
+                                  pointerType: number): boolean;
+
+        /**
+         * @param events Packed (type, x, y, pointerId, pointerType) tuples
+         * @returns The consumed flag of every event
+         */
+        public handlePointerEvents(events: Float64Array): Uint8Array;
+
+        public processDataSourceUpdate(payload: string, type: string): boolean;
+        public processDataSourceUpdates(updates: DataSourceUpdate[]): Uint8Array;
+        public adjustFetchRequest(type: string, payload: any): any;
+
+        public handleDisplayMetrics(metrics: APL.DisplayMetric[]): void;
+
+        public configurationChange(configurationChange: APL.ConfigurationChange,
+                                   metrics?: APL.Metrics,
+                                   scalingOptions?: any): void;
+
+        public getTextMeasurementCacheStats(): TextMeasurementCacheStats;
+
+        public setTextMeasurementCacheBudget(byteBudget: number): void;
+
+        public clearTextMeasurementCache(): void;
+
+        public updateDisplayState(displayState: any): void;
+
+        public setFocus(direction: number, origin: APL.Rect, targetId: string): void;
+
+        public getFocusableAreas(): Promise<Map<string, APL.Rect>>;
+
+        public getFocused(): Promise<string>;
+
+        public reInflate(): void;
+
+        public mediaLoaded(source: string): void;
+
+        public mediaLoadFailed(source: string, errorCode: number, error: string): void;
+    }
+}
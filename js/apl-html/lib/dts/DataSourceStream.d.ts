@@ -0,0 +1,14 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class DataSourceStream extends Deletable {
+        public static create(content : Content, name : string) : DataSourceStream;
+        public write(chunk : Uint8Array) : boolean;
+        public end() : boolean;
+        public getParsedBytes() : number;
+        public hasError() : boolean;
+    }
+}
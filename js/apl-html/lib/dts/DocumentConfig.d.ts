@@ -0,0 +1,11 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class DocumentConfig extends Deletable {
+        public static create() : DocumentConfig;
+        public processDataSourceUpdate(type : string, payload : string) : boolean;
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class DocumentContext extends Deletable {
+        /** True if the visual context changed since the last clearVisualContextDirty */
+        public isVisualContextDirty() : boolean;
+        public clearVisualContextDirty() : void;
+        public getVisualContext() : string;
+        public getVisualContextAs(mode : number) : any;
+        public isDataSourceContextDirty() : boolean;
+        public clearDataSourceContextDirty() : void;
+        public getDataSourceContext() : string;
+        public getDataSourceContextAs(mode : number) : any;
+        public executeCommands(commands : string, fastMode : boolean) : Action;
+        public executeCommandTemplate(name : string, args : any, fastMode : boolean) : Action;
+    }
+}
@@ -0,0 +1,17 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class DocumentManager extends Deletable {
+        /** @param requestCallback Called with every embed request core makes */
+        public static create(requestCallback : (requestId : number, url : string, headers : string[]) => void)
+            : DocumentManager;
+        public destroy() : void;
+        public embedRequestSucceeded(requestId : number, url : string, content : Content,
+                                     documentConfig : DocumentConfig | null,
+                                     connectedVisualContext : boolean) : DocumentContext;
+        public embedRequestFailed(requestId : number, url : string, failure : string) : void;
+    }
+}
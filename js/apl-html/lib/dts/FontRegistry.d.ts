@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class FontRegistry {
+        public static registerFont(family : string, weight : number, italic : boolean,
+                                   data : ArrayBuffer | ArrayBufferView) : boolean;
+        public static hasFonts() : boolean;
+        public static clear() : void;
+    }
+}
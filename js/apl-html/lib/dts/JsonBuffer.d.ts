@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class JsonBuffer {
+        public static allocate(length : number) : number;
+        public static fromArray(array : Uint8Array) : number;
+        public static free(address : number) : void;
+    }
+}
@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class KeyTable {
+        /** @returns The id of the value, or -1 once the table is full */
+        public static intern(value : string) : number;
+        public static getStrings() : string[];
+    }
+}
@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class MediaPlayer extends Deletable {
+        public getMediaPlayerHandle() : any;
+        public updateMediaState(state : any) : void;
+        public doCallback(eventType : number) : void;
+    }
+}
@@ -0,0 +1,12 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class MediaPlayerFactory extends Deletable {
+        /** @param playerFactory Creates the viewhost handle of a media player */
+        public static create(playerFactory : (mediaPlayer : MediaPlayer) => any) : MediaPlayerFactory;
+        public destroy() : void;
+    }
+}
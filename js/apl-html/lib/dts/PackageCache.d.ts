@@ -0,0 +1,27 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export interface PackageCacheStats {
+        hits: number;
+        misses: number;
+        entries: number;
+        bytes: number;
+        byteBudget: number;
+        inFlight: number;
+    }
+
+    export class PackageCache {
+        /** The key of the package of a request, as used by addPackage and addPackageSnapshot */
+        public static getKey(request : ImportRequest) : string;
+        public static addPackage(reference : string, packageJson : string) : boolean;
+        public static addPackageSnapshot(reference : string, snapshot : Uint8Array) : boolean;
+        public static addImportGraph(graph : {[reference : string] : PackageImport[]}) : void;
+        public static getImportGraph() : {[reference : string] : PackageImport[]};
+        public static clear() : void;
+        public static setByteBudget(byteBudget : number) : void;
+        public static getStats() : PackageCacheStats;
+    }
+}
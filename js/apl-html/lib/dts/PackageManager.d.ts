@@ -0,0 +1,14 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class PackageManager extends Deletable {
+        /** @param importPackageCallback Called with every package request core makes */
+        public static create(importPackageCallback : (request : ImportRequest) => void) : PackageManager;
+        public importPackageSucceeded(request : ImportRequest, packageJson : string) : void;
+        public importPackageFailed(request : ImportRequest, msg : string, code : number) : void;
+        public destroy() : void;
+    }
+}
@@ -0,0 +1,34 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export interface DynamicIndexListConfiguration {
+        cacheChunkSize?: number;
+        listUpdateBufferSize?: number;
+        fetchRetries?: number;
+        fetchTimeout?: number;
+        cacheExpiryTimeout?: number;
+    }
+
+    export class RootConfig extends Deletable {
+        public static create(environment : any) : RootConfig;
+        public utcTime(utcTime : number) : RootConfig;
+        public localTimeAdjustment(localTimeAdjustment : number) : RootConfig;
+        public localeMethods(localeMethods : any) : RootConfig;
+        public registerExtensionEventHandler(handler : ExtensionEventHandler) : RootConfig;
+        public registerExtensionCommand(commandDef : ExtensionCommandDefinition) : RootConfig;
+        public registerExtensionFilter(commandDef : ExtensionFilterDefinition) : RootConfig;
+        public registerExtensionEnvironment(uri : string, environment : any) : RootConfig;
+        public registerExtension(uri : string) : RootConfig;
+        public liveMap(name : string, obj : any) : RootConfig;
+        public liveArray(name : string, obj : any) : RootConfig;
+        public audioPlayerFactory(factory: AudioPlayerFactory) : RootConfig;
+        public mediaPlayerFactory(factory: MediaPlayerFactory) : RootConfig;
+        public documentManager(documentManager: DocumentManager): RootConfig;
+        public packageManager(packageManager: PackageManager) : RootConfig;
+        public textMeasurementMode(mode : 'dom' | 'native') : RootConfig;
+        public dynamicIndexListConfiguration(configuration : DynamicIndexListConfiguration) : RootConfig;
+    }
+}
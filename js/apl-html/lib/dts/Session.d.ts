@@ -0,0 +1,11 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export class Session extends Deletable {
+        /** @param logCommandCallback Receives the messages of the Log command */
+        public static create(logCommandCallback : (level : number, message : string, args : any) => void) : Session;
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+declare namespace APL {
+    export interface VisualContextNode {
+        uid : string;
+        /** uid of the parent node, empty for the root */
+        parent : string;
+        index : number;
+        /** Visual context entry without its children */
+        node : object;
+    }
+
+    export interface VisualContextReport {
+        type : 'full' | 'delta' | 'unchanged';
+        version : number;
+        /** Full reports only */
+        context? : object;
+        /** Deltas only, the version the delta applies to */
+        base? : number;
+        added? : VisualContextNode[];
+        removed? : string[];
+        changed? : VisualContextNode[];
+    }
+
+    export class VisualContextReporter extends Deletable {
+        /**
+         * @param fullEvery Number of deltas between two full reports, 0 for none
+         */
+        public static create(fullEvery : number) : VisualContextReporter;
+
+        /**
+         * @param mode 0 for a JSON string, 1 for a Uint8Array view of UTF-8 JSON in wasm memory,
+         *             2 for an object
+         */
+        public report(context : APL.DocumentContext, mode : number) : string | Uint8Array | VisualContextReport;
+        public reset() : void;
+        public getVersion() : number;
+    }
+}
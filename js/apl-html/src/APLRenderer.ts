@@ -30,6 +30,8 @@ import { createAplVersionUtils } from './utils/AplVersionUtils';
 import { browserIsEdge } from './utils/BrowserUtils';
 import { ARROW_DOWN, ARROW_LEFT, ARROW_RIGHT, ARROW_UP, ENTER_KEY, HttpStatusCodes, TAB_KEY } from './utils/Constant';
 import { isDisplayState } from './utils/DisplayStateUtils';
+import { DecodedEvent } from './utils/DecodedEventUtils';
+import { decodeFrameDelta } from './utils/FrameDeltaUtils';
 import { getCssGradient, getCssPureColorGradient } from './utils/ImageUtils';
 import { fetchMediaResource } from './utils/MediaRequestUtils';
 
@@ -42,6 +44,24 @@ const MAX_LEGACY_CLIPPING_APL_VERSION = '1.5';
 // setup a 500ms gap between two events.
 const pointerEventGap: number = 500;
 
+// With idleFrameScheduling, core timers due within this many milliseconds are served by the next animation frame
+const IDLE_FRAME_THRESHOLD: number = 16;
+const DEFAULT_MAX_IDLE_INTERVAL: number = 1000;
+// Events that wake up a sleeping frame loop. Listened to in the capture phase, so media events that
+// do not bubble are seen as well.
+const IDLE_WAKE_EVENTS = [
+    'keydown', 'keyup', 'touchstart', 'touchmove', 'touchend', 'touchcancel', 'mousedown', 'mousemove', 'mouseup',
+    'pointerdown', 'pointermove', 'pointerup', 'pointercancel', 'wheel', 'scroll', 'input', 'focus', 'blur', 'load',
+    'error', 'play', 'playing', 'pause', 'ended', 'seeked', 'timeupdate'
+];
+
+// Modifier bits of the keyboard events sent as KeyTable ids
+const KEY_MODIFIER_REPEAT: number = 1 << 0;
+const KEY_MODIFIER_ALT: number = 1 << 1;
+const KEY_MODIFIER_CTRL: number = 1 << 2;
+const KEY_MODIFIER_META: number = 1 << 3;
+const KEY_MODIFIER_SHIFT: number = 1 << 4;
+
 /**
  * Device viewport mode
  */
@@ -315,6 +335,37 @@ export interface IAPLOptions {
     metricsRecorder?: MetricsRecorder;
     /** Provide a fully populated IFluidityIncidentReporterOptions for incident reporting */
     fluidityIncidentReporterOptions?: IFluidityIncidentReporterOptions;
+    /**
+     * Sleep between core ticks while nothing is pending, until the next core timer or user input,
+     * instead of ticking on every animation frame.
+     */
+    idleFrameScheduling?: boolean;
+    /**
+     * Queue pointer events and hand them to core as one batch per frame, with consecutive moves of
+     * a pointer coalesced, instead of one call per DOM event.
+     */
+    batchPointerEvents?: boolean;
+    /**
+     * Hand keyboard events to core as interned code and key ids with a modifier bitmask, instead of
+     * a keyboard object that core reads property by property.
+     */
+    internKeyboardEvents?: boolean;
+    /**
+     * Have core convert the events of each frame in one call, with a resolve token per event,
+     * instead of handing out an event wrapper that is queried property by property.
+     */
+    decodeEvents?: boolean;
+    /**
+     * Largest number of items of a dynamicIndexList fetch request. Requests are widened up to it in
+     * the direction of a fast scroll, and requests covered by one in flight are dropped. 0 or unset
+     * sends requests as core makes them.
+     */
+    maxFetchWindow?: number;
+    /**
+     * Longest sleep in milliseconds with idleFrameScheduling, so time bound data such as localTime
+     * keeps updating. Defaults to 1000.
+     */
+    maxIdleInterval?: number;
 }
 
 /**
@@ -424,12 +475,46 @@ export default abstract class APLRenderer<Options = any> {
      */
     private requestId: any = undefined;
 
+    /**
+     * @internal
+     * @ignore
+     */
+    private idleTimeoutId: any = undefined;
+
+    /**
+     * Set when a frame is requested while one is already running, so the loop does not go to sleep
+     * after work that arrived too late to be counted as pending by core
+     * @internal
+     * @ignore
+     */
+    private wakeRequested: boolean = false;
+
+    /**
+     * Pointer events waiting for the next frame with batchPointerEvents, five numbers per event
+     * @internal
+     * @ignore
+     */
+    private pointerEventBatch: number[] = [];
+
+    /**
+     * KeyTable id of every code and key string seen, with internKeyboardEvents
+     * @internal
+     * @ignore
+     */
+    private keyIds: Map<string, number> | undefined = undefined;
+
     /**
      * @internal
      * @ignore
      */
     private lastDSTCheck: number = 0;
 
+    /**
+     * @internal
+     * @ignore
+     */
+    private localTimeAdjustment: number = 0;
+
     /**
      * @internal
      * @ignore
@@ -662,6 +747,11 @@ export default abstract class APLRenderer<Options = any> {
                 this.view.addEventListener(eventName, this.viewEventListeners[eventName]);
             }
         }
+        if (this.mOptions.idleFrameScheduling) {
+            for (const eventName of IDLE_WAKE_EVENTS) {
+                this.view.addEventListener(eventName, this.requestFrame, true);
+            }
+        }
     }
 
     public unbindFromView() {
@@ -673,6 +763,9 @@ export default abstract class APLRenderer<Options = any> {
                     this.view.removeEventListener(eventName, this.viewEventListeners[eventName]);
                 }
             }
+            for (const eventName of IDLE_WAKE_EVENTS) {
+                this.view.removeEventListener(eventName, this.requestFrame, true);
+            }
             this.view = undefined;
         }
     }
@@ -925,12 +1018,8 @@ export default abstract class APLRenderer<Options = any> {
     public onMeasure(component: APL.Component, measureWidth: number, widthMode: MeasureMode,
                      measureHeight: number, heightMode: MeasureMode) {
         this.reportMetricStart('TextMeasurement');
-        if (this.mOptions.viewport.maxWidth) {
-            measureWidth = Math.min(measureWidth, this.mOptions.viewport.maxWidth);
-        }
-        if (this.mOptions.viewport.maxHeight) {
-            measureHeight = Math.min(measureHeight, this.mOptions.viewport.maxHeight);
-        }
+        measureWidth = this.clampMeasureWidth(measureWidth);
+        measureHeight = this.clampMeasureHeight(measureHeight);
         const comp = new TextMeasurement(component, measureWidth, measureHeight);
         comp.init();
         const onMeasureResult = comp.onMeasure(measureWidth, widthMode, measureHeight, heightMode);
@@ -938,6 +1027,26 @@ export default abstract class APLRenderer<Options = any> {
         return onMeasureResult;
     }
 
+    /**
+     * Measures a batch of text components in a single DOM layout pass
+     * @param requests Components to measure with their constraints
+     * @return Measurement results in request order
+     * @ignore
+     */
+    public onMeasureBatch(requests: APL.TextMeasureRequest[]): APL.TextMeasureResult[] {
+        this.reportMetricStart('TextMeasurement');
+        const clamped = requests.map((request) => ({
+            component: request.component,
+            width: this.clampMeasureWidth(request.width),
+            widthMode: request.widthMode,
+            height: this.clampMeasureHeight(request.height),
+            heightMode: request.heightMode
+        }));
+        const results = TextMeasurement.measureBatch(clamped);
+        this.reportMetricEnd('TextMeasurement');
+        return results;
+    }
+
     /**
      * Rerender the same template with current content, config and context.
      */
@@ -958,10 +1067,13 @@ export default abstract class APLRenderer<Options = any> {
             }]);
             this.destroyRenderingComponents();
             if (!preserveContext) {
+                this.context.destroy();
                 this.context.delete();
             }
             (this.context as any) = undefined;
         }
+        this.cancelIdleTimeout();
+        this.pointerEventBatch.length = 0;
         this.removeRenderingComponents();
         if (this.view) {
             for (const eventName in this.viewEventListeners) {
@@ -969,6 +1081,9 @@ export default abstract class APLRenderer<Options = any> {
                     this.view.removeEventListener(eventName, this.viewEventListeners[eventName]);
                 }
             }
+            for (const eventName of IDLE_WAKE_EVENTS) {
+                this.view.removeEventListener(eventName, this.requestFrame, true);
+            }
             this.view = undefined;
         }
         if (this.metricsRecorder) {
@@ -1006,11 +1121,12 @@ export default abstract class APLRenderer<Options = any> {
      * Cancel Animation Frame
      */
     public async stopUpdate(): Promise<void> {
-        if (!this.requestId) {
+        if (!this.requestId && this.idleTimeoutId === undefined) {
             return;
         }
         window.cancelAnimationFrame(this.requestId);
         this.requestId = undefined;
+        this.cancelIdleTimeout();
         this.stopTime();
         this.paused = true;
         return Promise.resolve();
@@ -1020,7 +1136,7 @@ export default abstract class APLRenderer<Options = any> {
      * Resume Animation Frame
      */
     public async resumeUpdate(): Promise<void> {
-        if (this.requestId && !this.paused) {
+        if ((this.requestId || this.idleTimeoutId !== undefined) && !this.paused) {
             return;
         }
         this.paused = false;
@@ -1120,10 +1236,12 @@ export default abstract class APLRenderer<Options = any> {
     public mediaLoaded(source: string): void {
         if (this.context) {
             this.context.mediaLoaded(source);
+            this.requestFrame();
         } else {
             setTimeout(() => {
                 if (this.context) {
                     this.context.mediaLoaded(source);
+                    this.requestFrame();
                 }
             }, 200);
         }
@@ -1135,10 +1253,12 @@ export default abstract class APLRenderer<Options = any> {
     public mediaLoadFailed(source: string, errorCode: number, error: string): void {
         if (this.context) {
             this.context.mediaLoadFailed(source, errorCode, error);
+            this.requestFrame();
         } else {
             setTimeout(() => {
                 if (this.context) {
                     this.context.mediaLoadFailed(source, errorCode, error);
+                    this.requestFrame();
                 }
             }, 200);
         }
@@ -1161,18 +1281,15 @@ export default abstract class APLRenderer<Options = any> {
      * @internal
      * @ignore
      */
-    private updateTime(): void {
-        const now = Date.now();
+    private updateTimeAdjustment(now: number): void {
         if (isNaN(this.renderingStartTime) && !this.paused) {
             this.renderingStartTime = now;
         }
-        // move clock forward
-        this.context.updateTime(this.elapsed(), now);
 
         // Check once per second for a DST change or any other time-zone change
         if (now > this.lastDSTCheck + 1000) {
             const d = new Date();
-            this.context.setLocalTimeAdjustment(-d.getTimezoneOffset() * 60 * 1000);
+            this.localTimeAdjustment = -d.getTimezoneOffset() * 60 * 1000;
             this.lastDSTCheck = now;
         }
     }
@@ -1189,47 +1306,59 @@ export default abstract class APLRenderer<Options = any> {
     /**
      * APL Core relies on operations to be performed in particular way.
      * Order and set of operations in this method should be preserved.
-     * Order is the following:
+     * Order is the following, and is run by core in a single **tick** call:
+     * * Tick audio players.
      * * Update time and adjust TimeZone if required.
      * * Call **clearPending** method on RootConfig to give Core possibility to execute all pending actions and updates.
-     * * Process requested events.
-     * * Process dirty properties.
-     * * Check and set screenlock if required.
+     * * Collect requested events.
+     * Requested events are then processed, and a **collectFrame** call finishes the frame:
+     * * Collect dirty properties.
+     * * Check screenlock and pending errors.
      * @internal
      * @ignore
      */
-    private coreFrameUpdate(): void {
+    private coreFrameUpdate(): APL.FrameResult | undefined {
         const begin = Date.now();
-        if (this.getAudioPlayerFactory()) {
-            this.getAudioPlayerFactory().tick();
-        }
+        this.updateTimeAdjustment(begin);
 
-        this.updateTime();
+        this.flushPointerEvents();
+        const frameEvents = this.context.tick(this.elapsed(), begin, this.localTimeAdjustment);
 
-        this.context.clearPending();
+        for (const event of frameEvents.events) {
+            if (!this.context) {
+                break;
+            }
+            const coreEvent = frameEvents.decodedEvents ?
+                new DecodedEvent(event as APL.DecodedEvent, this.context) as any as APL.Event : event as APL.Event;
+            commandFactory(coreEvent, this);
+        }
 
-        while (this.context && this.context.hasEvent()) {
-            const event = this.context.popEvent();
-            commandFactory(event, this);
+        if (!this.context) {
+            return undefined;
         }
+        const frame = this.context.collectFrame();
+        // Decode before any other wasm call, the delta views point into wasm memory
+        const dirtyComponents = frame.delta ? decodeFrameDelta(frame.delta) : undefined;
 
-        if (this.content && !this.content.isReady()) {
-            return;
+        if (frame.hasPendingErrors) {
+            this.onRunTimeError(frame.errors);
+        }
+
+        if (!frame.ready) {
+            return frame;
         }
 
         if (this.context) {
-            if (this.context.isDirty()) {
+            if (dirtyComponents) {
                 this.checkAndUpdateViewportSize();
-                const dirtyComponents = this.context.getDirty();
-                for (const dirtyId of dirtyComponents) {
+                dirtyComponents.forEach((dirtyProps, dirtyId) => {
                     const component = this.componentMap[dirtyId];
                     if (component) {
-                        component.updateDirtyProps();
+                        component.updateDirtyProps(dirtyProps);
                     }
-                }
-                this.context.clearDirty();
+                });
             }
-            this.setScreenLock(this.context.screenLock());
+            this.setScreenLock(frame.screenLock);
         }
 
         const end = Date.now();
@@ -1243,6 +1372,7 @@ export default abstract class APLRenderer<Options = any> {
             this.reportMetricEnd('LayoutViews');
             this.isFirstTickAfterRender = false;
         }
+        return frame;
     }
 
     private reportFluidityEvent = (incidentId: number, frameStats: FrameStat[], upsValues: number[]) => {
@@ -1256,18 +1386,64 @@ export default abstract class APLRenderer<Options = any> {
      * @ignore
      */
     private update = (timestamp: number) => {
+        this.requestId = undefined;
+        this.wakeRequested = false;
         if (this.context) {
-            this.coreFrameUpdate();
-            if (this.context) {
-                const pendingErrors = this.context.getPendingErrors();
-                if (pendingErrors && pendingErrors.length) {
-                    this.onRunTimeError(pendingErrors);
-                }
-
+            const frame = this.coreFrameUpdate();
+            if (this.context && frame) {
                 this.dropFrameTick(timestamp);
-                this.requestId = requestAnimationFrame(this.update);
+                this.scheduleFrame(frame);
+            }
+        }
+    }
+
+    /**
+     * Request the next frame, or with idleFrameScheduling sleep until the next core timer when
+     * nothing else is pending.
+     * @internal
+     * @ignore
+     */
+    private scheduleFrame(frame: APL.FrameResult) {
+        if (this.mOptions.idleFrameScheduling && !frame.pendingWork && !this.wakeRequested) {
+            const delay = frame.nextTime - this.elapsed();
+            if (delay > IDLE_FRAME_THRESHOLD) {
+                const maxIdleInterval = this.mOptions.maxIdleInterval !== undefined ?
+                    this.mOptions.maxIdleInterval : DEFAULT_MAX_IDLE_INTERVAL;
+                // Frames are not tracked while sleeping, so the wake up does not count as dropped
+                this.previousTimeStamp = undefined;
+                this.idleTimeoutId = setTimeout(this.requestFrame, Math.min(delay, maxIdleInterval));
+                return;
             }
         }
+        this.requestId = requestAnimationFrame(this.update);
+    }
+
+    /**
+     * Wake up the frame loop if it is sleeping with idleFrameScheduling. Call it after any change
+     * made to the context outside of the renderer, so the change is rendered without delay.
+     */
+    public requestFrame = () => {
+        if (this.paused) {
+            return;
+        }
+        if (this.idleTimeoutId === undefined) {
+            // Not sleeping, make sure the running loop does not go to sleep after this frame
+            this.wakeRequested = true;
+            return;
+        }
+        this.cancelIdleTimeout();
+        this.requestId = requestAnimationFrame(this.update);
+    }
+
+    /**
+     * @internal
+     * @ignore
+     */
+    private cancelIdleTimeout() {
+        if (this.idleTimeoutId !== undefined) {
+            clearTimeout(this.idleTimeoutId);
+            this.idleTimeoutId = undefined;
+        }
     }
 
     /**
@@ -1373,6 +1549,7 @@ export default abstract class APLRenderer<Options = any> {
         if (this.context && this.view) {
             if (evt instanceof MouseEvent) {
                 const coords = this.getLeavingCoords(evt);
+                this.flushPointerEvents();
                 this.context.updateCursorPosition(coords.x, coords.y);
                 this.sendMousePointerEvent(evt, PointerEventType.kPointerCancel);
             } else if (evt instanceof TouchEvent) {
@@ -1389,7 +1566,7 @@ export default abstract class APLRenderer<Options = any> {
         const gap = (new Date()).getTime() - this.lastPointerEventTimestamp;
         if (gap > pointerEventGap) {
             const coords = this.getViewportCoords(evt);
-            this.context.handlePointerEvent(pointerEventType,
+            this.sendPointerEvent(pointerEventType,
                 coords.x, coords.y, APLRenderer.mousePointerId, PointerType.kMousePointer);
         }
     }
@@ -1399,7 +1576,7 @@ export default abstract class APLRenderer<Options = any> {
         for (let i = 0; i < touchCount; i++) {
             const touch: Touch = evt.changedTouches.item(i);
             const coords = this.getViewportCoords(touch);
-            this.context.handlePointerEvent(
+            this.sendPointerEvent(
                 pointerEventType,
                 coords.x,
                 coords.y,
@@ -1409,6 +1586,31 @@ export default abstract class APLRenderer<Options = any> {
         }
     }
 
+    private sendPointerEvent(pointerEventType: PointerEventType, x: number, y: number,
+                             pointerId: number, pointerType: PointerType) {
+        if (this.mOptions.batchPointerEvents) {
+            this.pointerEventBatch.push(pointerEventType, x, y, pointerId, pointerType);
+        } else {
+            this.context.handlePointerEvent(pointerEventType, x, y, pointerId, pointerType);
+        }
+    }
+
+    /**
+     * Hand the queued pointer events to core. Runs before every core tick, before any other
+     * cursor update and before key events, so core sees pointer and key input in DOM order.
+     * Events are packed in doubles, which hold every pointer id exactly.
+     * @internal
+     * @ignore
+     */
+    private flushPointerEvents() {
+        if (this.pointerEventBatch.length === 0) {
+            return;
+        }
+        const batch = new Float64Array(this.pointerEventBatch);
+        this.pointerEventBatch.length = 0;
+        this.context.handlePointerEvents(batch);
+    }
+
     private handleKeyDown = async (evt: IAsyncKeyboardEvent) => {
         await this.passKeyboardEventToCore(evt, KeyHandlerType.KeyDown);
     }
@@ -1434,6 +1636,30 @@ export default abstract class APLRenderer<Options = any> {
         return keyboard;
     }
 
+    private getKeyId(value: string): number {
+        if (!this.keyIds) {
+            this.keyIds = new Map<string, number>();
+            Module.KeyTable.getStrings().forEach((str, id) => this.keyIds!.set(str, id));
+        }
+        let id = this.keyIds.get(value);
+        if (id === undefined) {
+            // A full table answers -1, which is not cached so the map stays as bounded as the table
+            id = Module.KeyTable.intern(value);
+            if (id >= 0) {
+                this.keyIds.set(value, id);
+            }
+        }
+        return id;
+    }
+
+    private getKeyModifiers(keyboard: APL.Keyboard): number {
+        return (keyboard.repeat ? KEY_MODIFIER_REPEAT : 0) |
+            (keyboard.altKey ? KEY_MODIFIER_ALT : 0) |
+            (keyboard.ctrlKey ? KEY_MODIFIER_CTRL : 0) |
+            (keyboard.metaKey ? KEY_MODIFIER_META : 0) |
+            (keyboard.shiftKey ? KEY_MODIFIER_SHIFT : 0);
+    }
+
     private getKeyboardCodeInEdge = (evt: KeyboardEvent): string => {
         if (this.isDPadKey(evt.key)) {
             return evt.key;
@@ -1467,12 +1693,17 @@ export default abstract class APLRenderer<Options = any> {
             return;
         }
 
+        this.flushPointerEvents();
         const focusedComponentId = await this.context.getFocused();
 
         if (this.shouldPassKeyboardEventToCore(event, focusedComponentId)) {
             this.ensureComponentIsFocused(focusedComponentId, event.code);
             const keyboard: APL.Keyboard = this.getKeyboard(event);
-            const consumed = await this.context.handleKeyboard(handlerType, keyboard);
+            const codeId = this.mOptions.internKeyboardEvents ? this.getKeyId(keyboard.code) : -1;
+            const keyId = codeId >= 0 ? this.getKeyId(keyboard.key) : -1;
+            const consumed = keyId >= 0 ?
+                this.context.handleKeyboardCode(handlerType, codeId, keyId, this.getKeyModifiers(keyboard)) :
+                await this.context.handleKeyboard(handlerType, keyboard);
             if (consumed) {
                 event.preventDefault();
             }
@@ -1561,6 +1792,22 @@ export default abstract class APLRenderer<Options = any> {
         }
     }
 
+    /** @internal */
+    private clampMeasureWidth(measureWidth: number): number {
+        if (this.mOptions.viewport.maxWidth) {
+            return Math.min(measureWidth, this.mOptions.viewport.maxWidth);
+        }
+        return measureWidth;
+    }
+
+    /** @internal */
+    private clampMeasureHeight(measureHeight: number): number {
+        if (this.mOptions.viewport.maxHeight) {
+            return Math.min(measureHeight, this.mOptions.viewport.maxHeight);
+        }
+        return measureHeight;
+    }
+
     /**
      * @internal
      * @ignore
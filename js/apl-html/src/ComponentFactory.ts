@@ -6,7 +6,7 @@
 import APLRenderer from './APLRenderer';
 import { VectorGraphic } from './components/avg/VectorGraphic';
 import { VectorGraphicElementUpdater } from './components/avg/VectorGraphicElementUpdater';
-import { Component, IGenericPropType } from './components/Component';
+import { Component, IComponentSnapshotEntry, IGenericPropType } from './components/Component';
 import { Container } from './components/Container';
 import { EditText } from './components/EditText';
 import { Frame } from './components/Frame';
@@ -22,8 +22,10 @@ import { ComponentType } from './enums/ComponentType';
 
 export const componentFactory = (renderer: APLRenderer, component: APL.Component,
                                  parent?: Component, ensureLayout: boolean = false,
-                                 insertAt: number = -1 ): Component<IGenericPropType> => {
-    const id = component.getUniqueId();
+                                 insertAt: number = -1,
+                                 entry?: IComponentSnapshotEntry): Component<IGenericPropType> => {
+    const id = entry ? entry.uniqueId : component.getUniqueId();
+    const type = entry ? entry.type : component.getType();
     let comp;
     if (renderer.componentMap[id]) {
         comp = renderer.componentMap[id];
@@ -40,11 +42,11 @@ export const componentFactory = (renderer: APLRenderer, component: APL.Component
             }
         }
         return comp;
-    } else if (factoryMap[component.getType()]) {
-        comp = factoryMap[component.getType()](renderer, component, parent);
+    } else if (factoryMap[type]) {
+        comp = factoryMap[type](renderer, component, parent, entry);
     } else {
         // Any unknown component is effectively container
-        comp = new Container(renderer, component, componentFactory, parent);
+        comp = new Container(renderer, component, componentFactory, parent, entry);
     }
 
     if (ensureLayout) {
@@ -68,45 +70,45 @@ export const componentFactory = (renderer: APLRenderer, component: APL.Component
 
 // tslint:disable:max-line-length
 const factoryMap = {
-    [ComponentType.kComponentTypeContainer]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Container(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeContainer]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Container(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeEditText]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new EditText(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeEditText]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new EditText(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeFrame]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Frame(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeFrame]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Frame(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeImage]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Image(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeImage]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Image(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypePager]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new PagerComponent(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypePager]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new PagerComponent(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeScrollView]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new ScrollView(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeScrollView]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new ScrollView(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeSequence]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Sequence(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeSequence]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Sequence(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeGridSequence]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new GridSequence(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeGridSequence]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new GridSequence(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeText]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Text(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeText]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Text(renderer, component, componentFactory, parent, entry);
     },
-    [ComponentType.kComponentTypeTouchWrapper]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new TouchWrapper(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeTouchWrapper]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new TouchWrapper(renderer, component, componentFactory, parent, entry);
     },
     [ComponentType.kComponentTypeVideo]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
         return renderer.videoFactory.create(renderer, component, componentFactory, parent);
     },
     [ComponentType.kComponentTypeVectorGraphic]: (renderer: APLRenderer, component: APL.Component,
-                                                  parent?: Component) => {
-        return new VectorGraphic(renderer, component, componentFactory, new VectorGraphicElementUpdater(), parent);
+                                                  parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new VectorGraphic(renderer, component, componentFactory, new VectorGraphicElementUpdater(), parent, entry);
     },
-    [ComponentType.kComponentTypeHost]: (renderer: APLRenderer, component: APL.Component, parent?: Component) => {
-        return new Host(renderer, component, componentFactory, parent);
+    [ComponentType.kComponentTypeHost]: (renderer: APLRenderer, component: APL.Component, parent?: Component, entry?: IComponentSnapshotEntry) => {
+        return new Host(renderer, component, componentFactory, parent, entry);
     }
 };
 // tslint:enable:max-line-length
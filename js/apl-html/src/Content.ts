@@ -33,7 +33,17 @@ export class Content {
         if (other.data) {
             return new Content(other.doc, other.data, onLogCommand);
         }
-        return new Content(other.doc, JSON.stringify(other.dataMap), onLogCommand);
+        // Data added after creation is shared with the new content as it was parsed in wasm, whichever
+        // way it was added. Parameters without data take the payload member of the same name, and
+        // as when created with data, parameters that are still missing are filled.
+        const content = new Content(other.doc, '', onLogCommand);
+        const names = content.content.copyData(other.content);
+        content.getMainParameters().forEach((name: string) => {
+            if (names.indexOf(name) < 0) {
+                content.content.addData(name, '{}');
+            }
+        });
+        return content;
     }
 
     /**
@@ -81,12 +91,10 @@ export class Content {
         }
 
         if (this.data) {
-            const jsonDoc = JSON.parse(this.doc);
-            if (jsonDoc.mainTemplate && jsonDoc.mainTemplate.parameters &&
-                Array.isArray(jsonDoc.mainTemplate.parameters) &&
-                jsonDoc.mainTemplate.parameters.length > 0) {
+            const parameters = this.getMainParameters();
+            if (parameters.length > 0) {
                 const parsedData = JSON.parse(data);
-                jsonDoc.mainTemplate.parameters.forEach((name: string) => {
+                parameters.forEach((name: string) => {
                     if (name === 'payload') {
                         this.content.addData(name, data);
                     } else if (parsedData[name]) {
@@ -147,13 +155,63 @@ export class Content {
             console.warn('Created with datasource already, no-op for addData.');
             return;
         }
-        if (name === 'payload') {
-            this.dataMap = {...this.dataMap, ...JSON.parse(data)};
-        }
-        this.dataMap[name] = JSON.parse(data);
         this.content.addData(name, data);
     }
 
+    /**
+     * Add data from its UTF-8 bytes, such as a fetch response body. The bytes are copied once into
+     * the wasm heap and parsed there, without going through a JS string.
+     * @param name The name of the data source
+     * @param data The raw data source, UTF-8 encoded
+     * @param compressed True if the data is gzip or zlib compressed, it is then inflated in wasm as it is parsed
+     * @returns True if the data source parsed and was added. Otherwise the content is put in error.
+     */
+    public addDataBuffer(name: string, data: Uint8Array, compressed: boolean = false): boolean {
+        if (this.data) {
+            console.warn('Created with datasource already, no-op for addDataBuffer.');
+            return false;
+        }
+        const address = Module.JsonBuffer.fromArray(data);
+        if (address === 0) {
+            // Answer the parameter anyway, so the content does not wait for it forever
+            this.content.addData(name, '');
+            return false;
+        }
+        return compressed ?
+            this.content.addDataFromCompressedBuffer(name, address, data.length) :
+            this.content.addDataFromBuffer(name, address, data.length);
+    }
+
+    /**
+     * Add data as it downloads, such as from a fetch response body. Each chunk is parsed as it
+     * arrives, so a large data source does not block the main thread in one long parse.
+     * @param name The name of the data source
+     * @param data The raw data source, UTF-8 encoded
+     * @returns True if the data source parsed and was added
+     */
+    public async addDataStream(name: string, data: ReadableStream<Uint8Array>): Promise<boolean> {
+        if (this.data) {
+            console.warn('Created with datasource already, no-op for addDataStream.');
+            return false;
+        }
+        const stream = Module.DataSourceStream.create(this.content, name);
+        const reader = data.getReader();
+        try {
+            while (true) {
+                const { done, value } = await reader.read();
+                if (done) {
+                    return stream.end();
+                }
+                if (value && !stream.write(value)) {
+                    reader.cancel();
+                    return false;
+                }
+            }
+        } finally {
+            stream.delete();
+        }
+    }
+
     public refresh(metrics: APL.Metrics, config: APL.RootConfig): void {
         this.content.refresh(metrics, config);
     }
@@ -212,5 +270,17 @@ export class Content {
         return this.content.getParameterCount();
     }
 
-    private dataMap = {};
+    /**
+     * @internal
+     * @ignore
+     * @return The parameters of the main template of the document
+     */
+    private getMainParameters(): string[] {
+        const jsonDoc = JSON.parse(this.doc);
+        if (jsonDoc.mainTemplate && jsonDoc.mainTemplate.parameters &&
+            Array.isArray(jsonDoc.mainTemplate.parameters)) {
+            return jsonDoc.mainTemplate.parameters;
+        }
+        return [];
+    }
 }
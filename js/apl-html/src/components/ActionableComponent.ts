@@ -4,14 +4,15 @@
  */
 
 import APLRenderer from '../APLRenderer';
-import { Component, FactoryFunction, IGenericPropType } from './Component';
+import { Component, FactoryFunction, IComponentSnapshotEntry, IGenericPropType } from './Component';
 
 /**
  * @ignore
  */
 export class ActionableComponent<PropsType extends object = IGenericPropType> extends Component<PropsType> {
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         if (component.isFocusable()) {
             this.container.tabIndex = 0;
             this.focus = () => this.container.focus();
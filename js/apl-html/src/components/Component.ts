@@ -71,6 +71,35 @@ export const SVG_NS = 'http://www.w3.org/2000/svg';
 export const uuidv4 = require('uuid/v4');
 export const IDENTITY_TRANSFORM = 'matrix(1.000000,0.000000,0.000000,1.000000,0.000000,0.000000)';
 
+// Layout of a node in APL.ComponentSnapshot.nodes, see Component.snapshotSubtree
+const SNAPSHOT_NODE_SIZE = 5;
+const SNAPSHOT_TYPE = 2;
+const SNAPSHOT_CHILD_COUNT = 3;
+const SNAPSHOT_FIRST_CHILD = 4;
+
+/**
+ * What a subtree snapshot already holds of a component, so creating it takes no call into core.
+ * @ignore
+ */
+export interface IComponentSnapshotEntry {
+    type: number;
+    uniqueId: string;
+    id: string;
+}
+
+/**
+ * @param snapshot Snapshot of a subtree
+ * @param node Index of a node of the snapshot
+ * @ignore
+ */
+export const getSnapshotEntry = (snapshot: APL.ComponentSnapshot, node: number): IComponentSnapshotEntry => {
+    return {
+        type: snapshot.nodes[node * SNAPSHOT_NODE_SIZE + SNAPSHOT_TYPE],
+        uniqueId: snapshot.uniqueIds[node],
+        id: snapshot.ids[node]
+    };
+};
+
 /**
  * @ignore
  */
@@ -102,7 +131,7 @@ export interface IValueWithReference {
  */
 export type FactoryFunction = (renderer: APLRenderer, component: APL.Component,
                                parent?: Component<any>, ensureLayout?: boolean,
-                               insertAt?: number) => Component<any>;
+                               insertAt?: number, entry?: IComponentSnapshotEntry) => Component<any>;
 
 export type Executor = () => void;
 
@@ -138,6 +167,9 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
     /** User assigned ID */
     public assignedId: string;
 
+    /** Component type */
+    public componentType: ComponentType;
+
     /** true us destroyed was called */
     protected isDestroyed: boolean = false;
 
@@ -160,12 +192,15 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
      * @param component The core component
      * @param factory Factory function to create new components
      * @param parent The parent component
+     * @param entry The component in a subtree snapshot, if it was created from one
      * @ignore
      */
     constructor(public renderer: APLRenderer, public component: APL.Component,
-                protected factory: FactoryFunction, public parent?: Component<any>) {
+                protected factory: FactoryFunction, public parent?: Component<any>,
+                entry?: IComponentSnapshotEntry) {
         super();
-        this.logger = LoggerFactory.getLogger(COMPONENT_TYPE_MAP[component.getType()] || 'Component');
+        this.componentType = entry ? entry.type : component.getType();
+        this.logger = LoggerFactory.getLogger(COMPONENT_TYPE_MAP[this.componentType] || 'Component');
         this.$container.css({
             'position': 'absolute',
             'transform-origin': '0% 0%',
@@ -174,10 +209,10 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
             'box-sizing': 'border-box'
         });
         this.checkComponentTypeAndEnableClipping();
-        this.id = component.getUniqueId();
+        this.id = entry ? entry.uniqueId : component.getUniqueId();
         this.$container.attr('id', this.id);
 
-        this.assignedId = component.getId();
+        this.assignedId = entry ? entry.id : component.getId();
 
         if (renderer) {
             renderer.componentMap[this.id] = this;
@@ -185,7 +220,7 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
 
             const options = renderer.options as IAPLOptions;
             if (options && options.developerToolOptions && options.developerToolOptions.includeComponentId) {
-                this.$container.attr('data-componentid', component.getId());
+                this.$container.attr('data-componentid', this.assignedId);
             }
         }
 
@@ -227,22 +262,31 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
 
     /**
      * Creates all child components and initialized all calculated properties
+     * @param snapshot Snapshot of the subtree being initialized, taken when omitted
+     * @param node Index of this component in the snapshot
      * @ignore
      */
-    public init() {
-        const displayedChildren = this.getDisplayedChildren();
-        for (let i = 0; i < displayedChildren.length; i++) {
-            const childComponent = displayedChildren[i];
-            const child: Component = this.factory(this.renderer, childComponent, this);
+    public init(snapshot?: APL.ComponentSnapshot, node: number = 0) {
+        if (!snapshot) {
+            snapshot = this.component.snapshotSubtree(-1);
+            node = 0;
+        }
+        const base = node * SNAPSHOT_NODE_SIZE;
+        const childCount = snapshot.nodes[base + SNAPSHOT_CHILD_COUNT];
+        const firstChild = snapshot.nodes[base + SNAPSHOT_FIRST_CHILD];
+        for (let i = 0; i < childCount; i++) {
+            const childComponent = snapshot.components[firstChild + i]!;
+            const child: Component = this.factory(this.renderer, childComponent, this, false, -1,
+                getSnapshotEntry(snapshot, firstChild + i));
             this.container.appendChild(child.container);
             this.children[i] = child;
         }
 
-        const props = this.component.getCalculated() as PropsType;
+        const props = snapshot.props[node] as PropsType;
         this.setProperties(props);
         this.sizeToFit();
-        for (const child of this.children) {
-            child.init();
+        for (let i = 0; i < childCount; i++) {
+            this.children[i].init(snapshot, firstChild + i);
         }
     }
 
@@ -326,10 +370,11 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
 
     /**
      * Will update the view with any dirty properties
+     * @param dirtyProps Dirty properties already collected for this component. Fetched from core if not provided.
      * @ignore
      */
-    public updateDirtyProps() {
-        const props = this.component.getDirtyProps();
+    public updateDirtyProps(dirtyProps?: IGenericPropType) {
+        const props = dirtyProps || this.component.getDirtyProps();
         this.setProperties(props as PropsType);
     }
 
@@ -481,7 +526,7 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
             return;
         }
 
-        const parentIsContainerComponent = this.parent.component.getType() === ComponentType.kComponentTypeContainer;
+        const parentIsContainerComponent = this.parent.componentType === ComponentType.kComponentTypeContainer;
         const componentCanContainOtherItems = this.isLayout();
         const needsSizeToFit = parentIsContainerComponent
             && componentCanContainOtherItems;
@@ -648,16 +693,16 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
         // border width css property.
         let offsetTop = 0;
         let offsetLeft = 0;
-        if (this.parent && this.parent.component.getType() === ComponentType.kComponentTypeFrame) {
+        if (this.parent && this.parent.componentType === ComponentType.kComponentTypeFrame) {
             const frame = this.parent.component;
-            const drawnBorderWidth = frame.getCalculatedByKey<number>(PropertyKey.kPropertyDrawnBorderWidth);
+            const drawnBorderWidth = frame.getCalculatedNumber(PropertyKey.kPropertyDrawnBorderWidth);
             offsetTop -= drawnBorderWidth;
             offsetLeft -= drawnBorderWidth;
 
             // Set appropriate clipping path
             const parentRadii = frame.getCalculatedByKey<APL.Radii>(PropertyKey.kPropertyBorderRadii);
             const parentBounds = frame.getCalculatedByKey<APL.Rect>(PropertyKey.kPropertyBounds);
-            const borderWidth = frame.getCalculatedByKey<number>(PropertyKey.kPropertyBorderWidth);
+            const borderWidth = frame.getCalculatedNumber(PropertyKey.kPropertyBorderWidth);
 
             const outlineRadii: number[] = [
                 parentRadii.topLeft(),
@@ -813,14 +858,14 @@ export abstract class Component<PropsType extends object = IGenericPropType> ext
      *
      */
     private checkComponentTypeAndEnableClipping() {
-        const componentType = this.component.getType();
+        const componentType = this.componentType;
 
         // Don't clip for these components
         if (NO_CLIPPING_COMPONENTS_SET.has(componentType)) {
             return;
         }
 
-        const isParentLegacy = this.parent && LEGACY_CLIPPING_COMPONENTS_SET.has(this.parent.component.getType());
+        const isParentLegacy = this.parent && LEGACY_CLIPPING_COMPONENTS_SET.has(this.parent.componentType);
         const isLegacyComponentType: boolean = LEGACY_CLIPPING_COMPONENTS_SET.has(componentType);
         const isLegacyAplVersion: boolean = this.renderer && this.renderer.getLegacyClippingEnabled();
 
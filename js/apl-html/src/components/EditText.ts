@@ -12,7 +12,7 @@ import {UpdateType} from '../enums/UpdateType';
 import {ARROW_DOWN, ARROW_LEFT, ARROW_RIGHT, ARROW_UP, ENTER_KEY} from '../utils/Constant';
 import {FontUtils} from '../utils/FontUtils';
 import {ActionableComponent} from './ActionableComponent';
-import {Component, FactoryFunction, IComponentProperties} from './Component';
+import {Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry} from './Component';
 import {applyAplRectToStyle} from './helpers/StylesUtil';
 
 /**
@@ -51,8 +51,9 @@ export class EditText extends ActionableComponent<IEditTextProperties> {
     private enterPressedDown: boolean = false;
     private isEdge: boolean = /msie\s|trident\/|edge\//i.test(window.navigator.userAgent);
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.initEditTextHtmlComponent();
 
         this.inputElement.addEventListener('focus', this.focus);
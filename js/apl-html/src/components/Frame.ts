@@ -6,7 +6,7 @@
 import APLRenderer from '../APLRenderer';
 import { PropertyKey } from '../enums/PropertyKey';
 import { getCssGradient } from '../utils/ImageUtils';
-import { Component, FactoryFunction, IComponentProperties } from './Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from './Component';
 
 /**
  * @ignore
@@ -23,8 +23,9 @@ export interface IFrameProperties extends IComponentProperties {
  */
 export class Frame extends Component<IFrameProperties> {
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.$container.css({
             'border-style': 'solid',
             'background-clip': 'padding-box'
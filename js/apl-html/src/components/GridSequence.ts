@@ -4,7 +4,7 @@
  */
 
 import APLRenderer from '../APLRenderer';
-import { Component, FactoryFunction } from './Component';
+import { Component, FactoryFunction, IComponentSnapshotEntry } from './Component';
 import { MultiChildScrollable } from './MultiChildScrollable';
 
 /**
@@ -12,8 +12,9 @@ import { MultiChildScrollable } from './MultiChildScrollable';
  */
 export class GridSequence extends MultiChildScrollable {
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
     }
 
     protected getNormalDisplay(): string {
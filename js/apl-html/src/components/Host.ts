@@ -6,15 +6,16 @@
 import { PropertyKey } from '..';
 import APLRenderer from '../APLRenderer';
 import { getCssGradient } from '../utils/ImageUtils';
-import { Component, FactoryFunction, IComponentProperties } from './Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from './Component';
 
 export interface IHostProperties extends IComponentProperties {
     [PropertyKey.kPropertyBackground]: any;
 }
 
 export class Host extends Component<IHostProperties> {
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
 
         this.propExecutor
             (this.setBackground, PropertyKey.kPropertyBackground);
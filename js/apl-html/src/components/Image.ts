@@ -24,7 +24,7 @@ import {
     ImageDimensions, ScaledImageSource
 } from '../utils/ImageUtils';
 import {isSomething, Maybe, Nothing} from '../utils/Maybe';
-import {Component, FactoryFunction, IComponentProperties, SVG_NS, uuidv4} from './Component';
+import {Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry, SVG_NS, uuidv4} from './Component';
 import {createAligner} from './helpers/ImageAligner';
 import {createStylesApplier, CssUnitType, ElementType} from './helpers/StylesApplier';
 
@@ -84,8 +84,9 @@ export class Image extends Component<IImageProperties> {
         display: 'block'
     };
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
 
         this.propExecutor
         (this.setBorderRadius, PropertyKey.kPropertyBorderRadius)
@@ -97,8 +98,8 @@ export class Image extends Component<IImageProperties> {
         (this.fetchSource, PropertyKey.kPropertySource);
     }
 
-    public init() {
-        super.init();
+    public init(snapshot?: APL.ComponentSnapshot, node: number = 0) {
+        super.init(snapshot, node);
         this.prepareImageView();
         this.prepareImageOverlay();
         this.draw();
@@ -7,7 +7,7 @@ import APLRenderer from '../APLRenderer';
 import {PropertyKey} from '../enums/PropertyKey';
 import {ScrollDirection} from '../enums/ScrollDirection';
 import {processNextTick} from '../utils/EventUtils';
-import {Component, FactoryFunction, IComponentProperties} from './Component';
+import {Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry} from './Component';
 import {Scrollable} from './Scrollable';
 
 /**
@@ -25,8 +25,9 @@ export interface IMultiChildScrollableProperties extends IComponentProperties {
 export abstract class MultiChildScrollable extends Scrollable<IMultiChildScrollableProperties> {
     protected fullyLoaded = false;
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.container.classList.add('scrollView');
         // override or add more propExecutors
         this.propExecutor
@@ -34,8 +35,8 @@ export abstract class MultiChildScrollable extends Scrollable<IMultiChildScrolla
         (this.setScrollPosition, PropertyKey.kPropertyScrollPosition);
     }
 
-    public init() {
-        super.init();
+    public init(snapshot?: APL.ComponentSnapshot, node: number = 0) {
+        super.init(snapshot, node);
     }
 
     protected allowFocus(requestedDistance: number, moveTo: HTMLDivElement) {
@@ -5,7 +5,7 @@
 
 import * as $ from 'jquery';
 import APLRenderer from '../APLRenderer';
-import { Component, FactoryFunction, IComponentProperties } from './Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from './Component';
 import { Scrollable } from './Scrollable';
 
 /**
@@ -13,13 +13,14 @@ import { Scrollable } from './Scrollable';
  */
 export class ScrollView extends Scrollable<IComponentProperties> {
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.container.classList.add('scrollView');
     }
 
-    public init() {
-        super.init();
+    public init(snapshot?: APL.ComponentSnapshot, node: number = 0) {
+        super.init(snapshot, node);
     }
 
     /**
@@ -7,7 +7,7 @@ import APLRenderer from '../APLRenderer';
 import { ScrollDirection } from '../enums/ScrollDirection';
 import { UpdateType } from '../enums/UpdateType';
 import { ActionableComponent } from './ActionableComponent';
-import { Component, FactoryFunction, IComponentProperties } from './Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from './Component';
 
 /**
  * @ignore
@@ -37,8 +37,9 @@ export abstract class Scrollable<ScrollableProps extends object = IComponentProp
     protected side: 'left' | 'top' = 'top';
     protected hasFocusableChildren: boolean = false;
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         const onScroll = async (event: WheelEvent) => {
             event.preventDefault();
             const scrollPosition = this.getScrollPosition();
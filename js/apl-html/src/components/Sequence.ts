@@ -4,14 +4,15 @@
  */
 
 import APLRenderer from '../APLRenderer';
-import { Component, FactoryFunction } from './Component';
+import { Component, FactoryFunction, IComponentSnapshotEntry } from './Component';
 import { MultiChildScrollable} from './MultiChildScrollable';
 
 /**
  * @ignore
  */
 export class Sequence extends MultiChildScrollable {
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
     }
 }
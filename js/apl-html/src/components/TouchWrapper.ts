@@ -7,7 +7,7 @@ import APLRenderer from '../APLRenderer';
 import { PropertyKey } from '../enums/PropertyKey';
 import { ChildAction } from '../utils/Constant';
 import { ActionableComponent } from './ActionableComponent';
-import { Component, FactoryFunction, IComponentProperties } from './Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from './Component';
 
 /**
  * @ignore
@@ -20,8 +20,9 @@ export interface ITouchWrapperProperties extends IComponentProperties {
  * @ignore
  */
 export class TouchWrapper extends ActionableComponent<ITouchWrapperProperties> {
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
 
         // override or add more propExecutors
         this.propExecutor
@@ -12,7 +12,7 @@ import { VectorGraphicScale } from '../../enums/VectorGraphicScale';
 import { IURLRequest, parseHeaders, toUrlRequest } from '../../media/IURLRequest';
 
 import { ActionableComponent } from '../ActionableComponent';
-import { Component, FactoryFunction, IComponentProperties } from '../Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from '../Component';
 import { VectorGraphicElementUpdater } from './VectorGraphicElementUpdater';
 
 const SUPPORTED_GRAPHIC_LAYOUT_DIRECTIONS = {
@@ -49,8 +49,9 @@ export class VectorGraphic extends ActionableComponent<IVectorGraphicProperties>
                 component: APL.Component,
                 factory: FactoryFunction,
                 vectorGraphicUpdater: VectorGraphicElementUpdater,
-                parent?: Component) {
-        super(renderer, component, factory, parent);
+                parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.svg = document.createElementNS(VectorGraphic.SVG_NS, 'svg') as SVGElement;
         this.container.appendChild(this.svg);
         this.vectorGraphicUpdater = vectorGraphicUpdater;
@@ -6,7 +6,7 @@
 import APLRenderer from '../../APLRenderer';
 import { PropertyKey } from '../../enums/PropertyKey';
 import { ActionableComponent } from '../ActionableComponent';
-import { Component, FactoryFunction, IComponentProperties } from '../Component';
+import { Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry } from '../Component';
 
 /**
  * @ignore
@@ -21,8 +21,9 @@ export interface IPagerProperties extends IComponentProperties {
  */
 export class PagerComponent extends ActionableComponent<IPagerProperties> {
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
     }
 
     protected isLayout(): boolean {
@@ -13,7 +13,7 @@ import {TextAlignVertical} from '../../enums/TextAlignVertical';
 import {FontUtils} from '../../utils/FontUtils';
 import {replaceLastWordWithEllipsis, truncateEndWithEllipsis} from '../../utils/TextUtils';
 import {IComponentProperties} from '../Component';
-import {Component, FactoryFunction} from '../Component';
+import {Component, FactoryFunction, IComponentSnapshotEntry} from '../Component';
 import {Geometry, ILineRange} from './Geometry';
 import {MeasureMode} from './MeasureMode';
 import {RichTextParser} from './RichTextParser';
@@ -97,8 +97,9 @@ export class Text extends Component<ITextProperties> {
     private currentHighlighted: number = -1;
 
     /** @internal */
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
         this.richTextParser = new RichTextParser();
         if (renderer) {
             this.enableTextSelection = (renderer.options as IAPLOptions).enableTextSelection;
@@ -471,24 +472,57 @@ export class TextMeasurement extends Text {
         return ret;
     }
 
+    /**
+     * Measures several text components with one DOM insertion. All boxes are attached together and
+     * their natural widths read before any of them is resized, so the browser recalculates style
+     * and layout for the whole batch at once instead of once per component.
+     * @param requests Components to measure with their constraints
+     * @return Measurement results in request order
+     */
+    public static measureBatch(requests: APL.TextMeasureRequest[]): APL.TextMeasureResult[] {
+        const batchBox = document.createElement('div');
+        const measurements = requests.map((request) => {
+            const measurement = new TextMeasurement(request.component, request.width, request.height);
+            measurement.init();
+            measurement.resetMeasuredSize();
+            measurement.measurementBox.appendChild(measurement.textContainer);
+            batchBox.appendChild(measurement.measurementBox);
+            return measurement;
+        });
+        document.body.appendChild(batchBox);
+
+        const naturalWidths = measurements.map((measurement, i) =>
+            requests[i].widthMode === MeasureMode.Exactly ? undefined : measurement.textContainer.clientWidth);
+        const results = measurements.map((measurement, i) => measurement.measure(
+            requests[i].width, requests[i].widthMode, requests[i].height, requests[i].heightMode, naturalWidths[i]));
+
+        document.body.removeChild(batchBox);
+        return results;
+    }
+
     public onMeasure(
         width: number,
         widthMode: MeasureMode,
         height: number,
-        heightMode: MeasureMode): { width: number,
-                                    height: number,
-                                    baseline: number,
-                                    lineCount: number,
-                                    plainText: string,
-                                    laidOutText: string,
-                                    isTruncated: boolean,
-                                    textsByLine: string[],
-                                    rectsByLine: number[][] } {
+        heightMode: MeasureMode): APL.TextMeasureResult {
+        this.resetMeasuredSize();
+        this.addComponent();
+        const ret = this.measure(width, widthMode, height, heightMode);
+        this.removeComponent();
+        return ret;
+    }
+
+    protected resetMeasuredSize() {
         this.$textContainer.css('width', '');
         this.$textContainer.css('height', '');
+    }
 
-        this.addComponent();
-
+    protected measure(
+        width: number,
+        widthMode: MeasureMode,
+        height: number,
+        heightMode: MeasureMode,
+        naturalWidth?: number): APL.TextMeasureResult {
         const ret = {width: 0,
                      height: 0,
                      baseline: 0,
@@ -506,10 +540,13 @@ export class TextMeasurement extends Text {
             case MeasureMode.AtMost:
             case MeasureMode.Undefined:
             default:
+                if (naturalWidth === undefined) {
+                    naturalWidth = this.textContainer.clientWidth;
+                }
                 if (isNaN(width)) {
-                    ret.width = this.textContainer.clientWidth + 1;
+                    ret.width = naturalWidth + 1;
                 } else {
-                    ret.width = Math.min(width, this.textContainer.clientWidth + 1);
+                    ret.width = Math.min(width, naturalWidth + 1);
                 }
         }
         this.$textContainer.css('width', ret.width);
@@ -565,8 +602,6 @@ export class TextMeasurement extends Text {
         ret.height = this.textContainer.clientHeight === 0 ? lineSpace : this.textContainer.clientHeight + 1;
         ret.baseline = ret.height * 0.5;
         this.$textContainer.css('height', ret.height);
-
-        this.removeComponent();
         return ret;
     }
 
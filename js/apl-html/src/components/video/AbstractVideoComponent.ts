@@ -9,7 +9,7 @@ import {PropertyKey} from '../../enums/PropertyKey';
 import {VideoScale} from '../../enums/VideoScale';
 import {IMediaSource} from '../../media/IMediaSource';
 import { PlaybackState } from '../../media/Resource';
-import {Component, FactoryFunction, IComponentProperties} from '../Component';
+import {Component, FactoryFunction, IComponentProperties, IComponentSnapshotEntry} from '../Component';
 
 /**
  * @ignore
@@ -32,8 +32,9 @@ export abstract class AbstractVideoComponent extends Component<IVideoProperties>
     protected constructor(renderer: APLRenderer,
                           component: APL.Component,
                           factory: FactoryFunction,
-                          parent?: Component) {
-        super(renderer, component, factory, parent);
+                          parent?: Component,
+                          entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
 
         this.propExecutor
         (this.setScaleFromProp, PropertyKey.kPropertyScale);
@@ -10,7 +10,7 @@ import {LoggerFactory} from '../../logging/LoggerFactory';
 import {IMediaPlayerHandle} from '../../media/IMediaPlayerHandle';
 import {VideoInterface} from '../../media/MediaEventSequencer';
 import {PlaybackState} from '../../media/Resource';
-import {Component, FactoryFunction} from '../Component';
+import {Component, FactoryFunction, IComponentSnapshotEntry} from '../Component';
 import {AbstractVideoComponent} from './AbstractVideoComponent';
 
 const logger: ILogger = LoggerFactory.getLogger('Video');
@@ -21,8 +21,9 @@ export class Video extends AbstractVideoComponent {
     private readonly videoEventProcessor: any;
     private mediaPlayerHandle: IMediaPlayerHandle;
 
-    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component) {
-        super(renderer, component, factory, parent);
+    constructor(renderer: APLRenderer, component: APL.Component, factory: FactoryFunction, parent?: Component,
+                entry?: IComponentSnapshotEntry) {
+        super(renderer, component, factory, parent, entry);
 
         this.mediaPlayerHandle = component.getMediaPlayer().getMediaPlayerHandle();
         if (this.mediaPlayerHandle) {
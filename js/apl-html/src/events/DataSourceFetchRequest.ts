@@ -13,7 +13,8 @@ export class DataSourceFetchRequest extends Event {
 
     public async execute() {
         const type = this.event.getValue<string>(EventProperty.kEventPropertyName);
-        const payload = this.event.getValue<any>(EventProperty.kEventPropertyValue);
+        const payload = this.renderer.context.adjustFetchRequest(type,
+            this.event.getValue<any>(EventProperty.kEventPropertyValue));
         this.renderer.onDataSourceFetchRequest({type, payload});
         this.resolve();
         this.destroy();
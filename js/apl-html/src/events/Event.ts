@@ -40,10 +40,31 @@ export abstract class Event {
 
     public terminate() {
         this.isTerminated = true;
+        this.requestFrame();
     }
 
     protected resolve() {
         this.event.resolve();
+        this.requestFrame();
+    }
+
+    protected resolveWithArg(arg: number) {
+        this.event.resolveWithArg(arg);
+        this.requestFrame();
+    }
+
+    protected resolveWithRect(x: number, y: number, width: number, height: number) {
+        this.event.resolveWithRect(x, y, width, height);
+        this.requestFrame();
+    }
+
+    /**
+     * Wake up the frame loop, core has work to do once the event is resolved or terminated.
+     */
+    protected requestFrame() {
+        if (this.renderer) {
+            this.renderer.requestFrame();
+        }
     }
 
     protected async waitForValidLayout(component: APL.Component): Promise<void> {
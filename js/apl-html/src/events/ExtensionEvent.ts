@@ -18,9 +18,9 @@ export class ExtensionEvent extends Event {
 
         const result = await this.renderer.onExtensionEvent({uri, event : this.event, name, source, params});
         if (!result) {
-            this.event.resolveWithArg(1);
+            this.resolveWithArg(1);
         } else {
-            this.event.resolve();
+            this.resolve();
         }
     }
 }
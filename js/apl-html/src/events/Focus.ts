@@ -21,17 +21,17 @@ export class Focus extends Event {
             if (viewhostComponent && viewhostComponent.focus) {
                 viewhostComponent.focus();
             }
-            this.event.resolve();
+            this.resolve();
         } else {
             const direction = this.event.getValue<FocusDirection>(EventProperty.kEventPropertyDirection);
             if (direction !== FocusDirection.kFocusDirectionNone) {
                 if (!this.renderer.focusTrapped()) {
                     this.focusOnNextElement(direction);
-                    this.event.resolve();
+                    this.resolve();
                 }
             } else {
                 (document.activeElement as HTMLElement).blur();
-                this.event.resolveWithArg(1);
+                this.resolveWithArg(1);
             }
         }
     }
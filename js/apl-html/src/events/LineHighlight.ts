@@ -29,6 +29,6 @@ export class LineHighlight extends Event {
             const lineNumber = this.component.getLineByRange(rangeStart, rangeEnd);
             this.component.highlight(lineNumber);
         }
-        this.event.resolve();
+        this.resolve();
     }
 }
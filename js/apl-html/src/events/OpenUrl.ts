@@ -15,9 +15,9 @@ export class OpenUrl extends Event {
         const source = this.event.getValue<string>(EventProperty.kEventPropertySource);
         const supported = await this.renderer.onOpenUrl(source);
         if (!supported) {
-            this.event.resolveWithArg(1);
+            this.resolveWithArg(1);
         } else {
-            this.event.resolve();
+            this.resolve();
         }
     }
 }
@@ -14,7 +14,7 @@ export class ReInflate extends Event {
         this.renderer.destroyRenderingComponents();
         await this.renderer.context.reInflate();
         this.renderer.reRenderComponents();
-        this.event.resolve();
+        this.resolve();
         this.destroy();
     }
 }
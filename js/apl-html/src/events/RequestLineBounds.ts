@@ -20,7 +20,7 @@ export class RequestLineBounds extends Event {
         const rangeEnd = this.event.getValue<number>(EventProperty.kEventPropertyRangeEnd);
 
         if (rangeStart < 0 || rangeEnd < 0) {
-            this.event.resolveWithRect(0, 0, 0, 0);
+            this.resolveWithRect(0, 0, 0, 0);
             return;
         }
 
@@ -32,9 +32,9 @@ export class RequestLineBounds extends Event {
             const top = line ? line.top : 0;
             const height = line ? line.height : 0;
 
-            this.event.resolveWithRect(0, top, this.component.bounds.width, height);
+            this.resolveWithRect(0, top, this.component.bounds.width, height);
         } else if (this.component === undefined) {
-            this.event.resolveWithRect(0, 0, 0, 0);
+            this.resolveWithRect(0, 0, 0, 0);
         }
     }
 }
@@ -0,0 +1,83 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Token of the decoded events that nothing waits on. Must match apl::wasm::EventRegistry::INVALID_TOKEN.
+ */
+const INVALID_TOKEN = 0;
+
+/**
+ * Event returned by `APL.Context.drainEvents()`, exposing the same accessors as APL.Event.
+ * Values are read from the decoded object; only resolving and the component lookup reach wasm.
+ */
+export class DecodedEvent {
+    private resolved: boolean = false;
+    private terminated: boolean = false;
+
+    constructor(private decoded: APL.DecodedEvent, private context: APL.Context) {}
+
+    public getType(): number {
+        return this.decoded.type;
+    }
+
+    public getValue<T>(key: number): T {
+        return (key in this.decoded.values ? this.decoded.values[key] : null) as T;
+    }
+
+    public getComponent(): APL.Component {
+        return this.context.getComponentByHandle(this.decoded.componentHandle) as APL.Component;
+    }
+
+    public getComponentHandle(): number {
+        return this.decoded.componentHandle;
+    }
+
+    public resolve() {
+        if (this.isPending()) {
+            this.resolved = true;
+            this.context.resolveEvent(this.decoded.token);
+        }
+    }
+
+    public resolveWithArg(arg: number) {
+        if (this.isPending()) {
+            this.resolved = true;
+            this.context.resolveEventWithArg(this.decoded.token, arg);
+        }
+    }
+
+    public resolveWithRect(x: number, y: number, width: number, height: number): void {
+        if (this.isPending()) {
+            this.resolved = true;
+            this.context.resolveEventWithRect(this.decoded.token, x, y, width, height);
+        }
+    }
+
+    public addTerminateCallback(callback: () => void) {
+        if (this.decoded.token === INVALID_TOKEN) {
+            return;
+        }
+        this.context.addEventTerminateCallback(this.decoded.token, () => {
+            this.terminated = true;
+            callback();
+        });
+    }
+
+    public isPending(): boolean {
+        return this.decoded.token !== INVALID_TOKEN && !this.resolved && !this.terminated;
+    }
+
+    public isTerminated(): boolean {
+        return this.terminated;
+    }
+
+    public isResolved(): boolean {
+        return this.resolved;
+    }
+
+    public delete() {
+        (this.context as any) = undefined;
+    }
+}
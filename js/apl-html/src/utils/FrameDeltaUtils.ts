@@ -0,0 +1,97 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Value kinds written by the wasm FrameDelta packer. Must match apl::wasm::FrameDelta::ValueKind.
+ */
+export enum FrameDeltaValueKind {
+    kValueKindUndefined = 0,
+    kValueKindNumber = 1,
+    kValueKindBoolean = 2,
+    kValueKindColor = 3,
+    kValueKindString = 4,
+    kValueKindRect = 5,
+    kValueKindRadii = 6,
+    kValueKindObject = 7
+}
+
+const HEADER_SIZE = 2;
+const COMPONENT_SIZE = 2;
+const RECORD_SIZE = 7;
+
+const textDecoder = new TextDecoder('utf-8');
+
+/**
+ * Packed radii exposing the same accessors as APL.Radii
+ */
+class PackedRadii {
+    constructor(private tl: number, private tr: number, private bl: number, private br: number) {}
+    public topLeft(): number { return this.tl; }
+    public topRight(): number { return this.tr; }
+    public bottomLeft(): number { return this.bl; }
+    public bottomRight(): number { return this.br; }
+}
+
+/**
+ * Decodes the packed frame delta returned by `APL.Context.collectFrameDelta()`.
+ *
+ * The views reference wasm memory directly, so the delta must be decoded before any
+ * other call into wasm.
+ * @param delta Packed frame delta
+ * @return Map of component unique ID to its dirty properties
+ */
+export function decodeFrameDelta(delta: APL.FrameDelta): Map<string, {[key: number]: any}> {
+    const buffer = delta.buffer;
+    const strings = delta.strings;
+    const decodeString = (offset: number, length: number): string => {
+        return textDecoder.decode(strings.subarray(offset, offset + length));
+    };
+
+    const componentCount = buffer[0];
+    const recordCount = buffer[1];
+    const ids: string[] = new Array(componentCount);
+    const dirtyProps = new Map<string, {[key: number]: any}>();
+    for (let i = 0; i < componentCount; i++) {
+        const offset = HEADER_SIZE + i * COMPONENT_SIZE;
+        ids[i] = decodeString(buffer[offset], buffer[offset + 1]);
+        dirtyProps.set(ids[i], {});
+    }
+
+    let offset = HEADER_SIZE + componentCount * COMPONENT_SIZE;
+    for (let i = 0; i < recordCount; i++, offset += RECORD_SIZE) {
+        const props = dirtyProps.get(ids[buffer[offset]]);
+        const key = buffer[offset + 1];
+        const p0 = buffer[offset + 3];
+        const p1 = buffer[offset + 4];
+        const p2 = buffer[offset + 5];
+        const p3 = buffer[offset + 6];
+        switch (buffer[offset + 2]) {
+            case FrameDeltaValueKind.kValueKindNumber:
+            case FrameDeltaValueKind.kValueKindColor:
+                props[key] = p0;
+                break;
+            case FrameDeltaValueKind.kValueKindBoolean:
+                props[key] = p0 !== 0;
+                break;
+            case FrameDeltaValueKind.kValueKindString:
+                props[key] = decodeString(p0, p1);
+                break;
+            case FrameDeltaValueKind.kValueKindRect:
+                props[key] = {left: p0, top: p1, width: p2, height: p3};
+                break;
+            case FrameDeltaValueKind.kValueKindRadii:
+                props[key] = new PackedRadii(p0, p1, p2, p3);
+                break;
+            case FrameDeltaValueKind.kValueKindObject:
+                props[key] = delta.objects[p0];
+                break;
+            case FrameDeltaValueKind.kValueKindUndefined:
+            default:
+                props[key] = undefined;
+                break;
+        }
+    }
+    return dirtyProps;
+}
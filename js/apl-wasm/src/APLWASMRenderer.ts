@@ -10,6 +10,7 @@ import APLRenderer, {
     LocaleMethods, LoggerFactory, LogTransport, MediaPlayerHandle, OnLogCommand,
     Segment, ViewportShape
 } from 'apl-html';
+import { decodeJsonView, JsonBridgeMode } from './common/JsonBridge';
 import { ConfigurationChange } from './ConfigurationChange';
 import { PackageLoader } from './content/PackageLoader';
 import { PackageManager } from './content/PackageManager';
@@ -56,8 +57,40 @@ export interface IAPLWASMOptions extends IAPLOptions {
     extensionManager?: ExtensionManager;
     /** Document State to restore */
     documentState?: IDocumentState;
+    /** Byte budget of the text measurement layout cache, 0 to disable. Defaults to 1MB. */
+    textMeasurementCacheBudget?: number;
+    /** Measure text in one batch per inflation instead of one DOM layout per text component. */
+    batchTextMeasurement?: boolean;
+    /**
+     * 'native' measures text in wasm from the fonts registered with Module.FontRegistry, without the DOM.
+     * Defaults to 'dom'.
+     */
+    textMeasurementMode?: 'dom' | 'native';
+    /** Configuration of the dynamicIndexList data source, such as its cacheChunkSize and fetchTimeout */
+    dynamicIndexListConfiguration?: APL.DynamicIndexListConfiguration;
     /** Override package download. Reject the Promise to fallback to the default logic. */
     packageLoader?: (name: string, version: string, url?: string, domain?: string) => Promise<string>;
+    /**
+     * Load the binary snapshot of a package, built by the apl-snapshot tool, which skips JSON parsing.
+     * Resolve to undefined, or to a snapshot that is rejected, to fall back to the JSON package.
+     */
+    packageSnapshotLoader?: (name: string, version: string, url?: string) => Promise<Uint8Array | undefined>;
+    /**
+     * Number of visual context deltas between two full reports of getVisualContextReport().
+     * 0 only reports the first visual context in full. Defaults to 0.
+     */
+    visualContextFullEvery?: number;
+    /**
+     * Fetch the nested imports of a document in parallel up front, from the import graphs seen by
+     * earlier documents and sessions, instead of one import layer per round trip.
+     */
+    prefetchPackages?: boolean;
+    /**
+     * Package dependency graphs known ahead of time: package key to imports. The key is the package
+     * reference ("name:version"), followed by "|domain|source" for packages with a domain or source.
+     * The nested imports it lists are fetched up front, as with prefetchPackages.
+     */
+    packageManifest?: {[reference: string]: APL.PackageImport[]};
     /** callback for APL Log Command handling, will overwrite the callback during Content creation */
     onLogCommand?: OnLogCommand;
     /** @internal */
@@ -113,6 +146,9 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
 
     private onDocumentStateUpdate?: (state: DocumentState) => void;
 
+    /// Incremental visual context reports, created on first use
+    private visualContextReporter?: APL.VisualContextReporter;
+
     private coreDocumentContext: APL.DocumentContext;
 
     /**
@@ -173,6 +209,7 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
         this.handleUpdateDisplayState = (displayState: DisplayState) => {
             if (this.context) {
                 this.context.updateDisplayState(displayState);
+                this.requestFrame();
             }
         };
 
@@ -180,6 +217,12 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
             this.rootConfig = Module.RootConfig.create(this.options.environment);
             this.rootConfig.utcTime(this.options.utcTime).localTimeAdjustment(this.options.localTimeAdjustment);
             this.rootConfig.localeMethods(LocaleMethods);
+            if (this.options.textMeasurementMode) {
+                this.rootConfig.textMeasurementMode(this.options.textMeasurementMode);
+            }
+            if (this.options.dynamicIndexListConfiguration) {
+                this.rootConfig.dynamicIndexListConfiguration(this.options.dynamicIndexListConfiguration);
+            }
 
             this.audioPlayerFactory = Module.AudioPlayerFactory.create(
                 this.options.audioPlayerFactory ?
@@ -193,7 +236,10 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
             this.rootConfig.mediaPlayerFactory(this.mediaPlayerFactory);
 
             this.packageLoader = new PackageLoader(this.options.packageLoader);
-            this.packageManager = new PackageManager(this.packageLoader);
+            this.packageManager = new PackageManager(this.packageLoader, this.options.packageSnapshotLoader);
+            if (this.options.prefetchPackages || this.options.packageManifest) {
+                PackageManager.loadImportGraph(this.options.packageManifest, this.options.prefetchPackages);
+            }
             this.rootConfig.packageManager(this.packageManager.getCppPackageManager());
         }
 
@@ -366,6 +412,7 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
         inflateViewsSegment?.stop();
 
         if (this.extensionManager) {
+            this.extensionManager.requestFrame = this.requestFrame;
             this.extensionManager.onDocumentRender(this.context, this.content.getContent());
         }
         return Promise.resolve();
@@ -391,7 +438,39 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      * @param commands JSON string of an array of commands
      */
     public executeCommands(commands: string): APL.Action {
-        return this.coreDocumentContext.executeCommands(commands, false);
+        const action = this.coreDocumentContext.executeCommands(commands, false);
+        this.requestFrame();
+        return action;
+    }
+
+    /**
+     * Register a command template once, then run it with only the values that change.
+     * String values of the form "{{name}}" are replaced by the matching argument.
+     * ```
+     * renderer.registerCommandTemplate('goToPage', JSON.stringify([{
+     *     type: 'SetPage',
+     *     componentId: 'pager',
+     *     value: '{{page}}'
+     * }]));
+     * renderer.executeCommandTemplate('goToPage', { page: 2 });
+     * ```
+     * @param name Name of the template
+     * @param commands JSON string of an array of commands
+     * @returns true if the commands were parsed
+     */
+    public registerCommandTemplate(name: string, commands: string): boolean {
+        return Module.CommandCache.registerTemplate(name, commands);
+    }
+
+    /**
+     * Execute a template registered with registerCommandTemplate
+     * @param name Name of the template
+     * @param args Value of each placeholder
+     */
+    public executeCommandTemplate(name: string, args?: {[name: string]: any}): APL.Action | null {
+        const action = this.coreDocumentContext.executeCommandTemplate(name, args, false);
+        this.requestFrame();
+        return action;
     }
 
     /**
@@ -414,7 +493,9 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      * @param fastMode true if should be executed in fast mode, false otherwise.
      */
     public invokeExtensionEventHandler(uri: string, name: string, data: string, fastMode: boolean): APL.Action {
-        return this.context.invokeExtensionEventHandler(uri, name, data, fastMode);
+        const action = this.context.invokeExtensionEventHandler(uri, name, data, fastMode);
+        this.requestFrame();
+        return action;
     }
 
     /**
@@ -423,6 +504,7 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      */
     public cancelExecution() {
         this.context.cancelExecution();
+        this.requestFrame();
     }
 
     /**
@@ -431,7 +513,20 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      * @param type DataSource type. Optional, should be one of runtime registered.
      */
     public processDataSourceUpdate(payload: string, type?: string): boolean {
-        return this.context.processDataSourceUpdate(payload, type ? type : 'dynamicIndexList');
+        const processed = this.context.processDataSourceUpdate(payload, type ? type : 'dynamicIndexList');
+        this.requestFrame();
+        return processed;
+    }
+
+    /**
+     * Process several DataSource update payloads with one call into core and one frame.
+     * @param updates DataSource update payloads, the type defaulting to dynamicIndexList.
+     * @returns For each update, whether it was processed.
+     */
+    public processDataSourceUpdates(updates: APL.DataSourceUpdate[]): boolean[] {
+        const processed = this.context.processDataSourceUpdates(updates);
+        this.requestFrame();
+        return Array.from(processed, (value) => value === 1);
     }
 
     /**
@@ -439,7 +534,28 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      * @ignore
      */
     public getVisualContext(): Promise<string> {
-        return Promise.resolve(this.coreDocumentContext.getVisualContext());
+        const view = this.coreDocumentContext.getVisualContextAs(JsonBridgeMode.kModeView);
+        return Promise.resolve(decodeJsonView(view));
+    }
+
+    /**
+     * Visual context as an object, built by core without a JSON round trip
+     */
+    public getVisualContextObject(): Promise<object> {
+        return Promise.resolve(this.coreDocumentContext.getVisualContextAs(JsonBridgeMode.kModeObject));
+    }
+
+    /**
+     * Visual context as changes since the previous call: a full report the first time, then deltas
+     * of added, removed and changed nodes. See `visualContextFullEvery` for periodic full reports.
+     */
+    public getVisualContextReport(): Promise<APL.VisualContextReport> {
+        if (!this.visualContextReporter) {
+            const fullEvery = this.options.visualContextFullEvery ? this.options.visualContextFullEvery : 0;
+            this.visualContextReporter = Module.VisualContextReporter.create(fullEvery);
+        }
+        return Promise.resolve(this.visualContextReporter.report(this.coreDocumentContext,
+            JsonBridgeMode.kModeObject) as APL.VisualContextReport);
     }
 
     /**
@@ -447,7 +563,15 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      * @ignore
      */
     public getDataSourceContext(): Promise<string> {
-        return Promise.resolve(this.coreDocumentContext.getDataSourceContext());
+        const view = this.coreDocumentContext.getDataSourceContextAs(JsonBridgeMode.kModeView);
+        return Promise.resolve(decodeJsonView(view));
+    }
+
+    /**
+     * Data source context as an object, built by core without a JSON round trip
+     */
+    public getDataSourceContextObject(): Promise<object> {
+        return Promise.resolve(this.coreDocumentContext.getDataSourceContextAs(JsonBridgeMode.kModeObject));
     }
 
     /**
@@ -456,10 +580,17 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
      */
     public updateCoreDocumentContext(documentContext: APL.DocumentContext) {
         this.coreDocumentContext = documentContext;
+        if (this.visualContextReporter) {
+            this.visualContextReporter.reset();
+        }
     }
 
     public destroy(preserveContext?: boolean) {
         super.destroy(preserveContext);
+        if (this.visualContextReporter) {
+            this.visualContextReporter.delete();
+            this.visualContextReporter = undefined;
+        }
         if (!preserveContext) {
             if (!this.unifiedApi && this.audioPlayerFactory) {
                 this.audioPlayerFactory.destroy();
@@ -480,10 +611,19 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
         const prepareContentSegment =
             this.metricsRecorder?.startTimer(Segment.kPrepareContent, new Map<string, string>());
 
+        const prefetch = (this.options.prefetchPackages || this.options.packageManifest) && this.packageManager;
+        if (prefetch) {
+            // Core requests the packages being prefetched like any other, and waits for the same download
+            this.packageManager.prefetch(this.content.getContent());
+        }
+
         return new Promise<boolean>((resolve) => {
             this.content.getContent().load(
                 () => {
                     prepareContentSegment?.stop();
+                    if (this.options.prefetchPackages && this.packageManager) {
+                        PackageManager.saveImportGraph();
+                    }
                     resolve(true);
                 },
                 () => {
@@ -521,6 +661,7 @@ export class APLWASMRenderer extends APLRenderer<IAPLWASMOptions> {
             this.context.configurationChange(configurationChange.getConfigurationChange(),
                 undefined, undefined);
         }
+        this.requestFrame();
     }
 
     /**
@@ -0,0 +1,26 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * How serialized core state is handed over. Must match apl::wasm::JsonBridge::Mode.
+ */
+export enum JsonBridgeMode {
+    /** JSON string */
+    kModeString = 0,
+    /** Uint8Array view of UTF-8 JSON in wasm memory */
+    kModeView = 1,
+    /** JS object */
+    kModeObject = 2
+}
+
+const textDecoder = new TextDecoder('utf-8');
+
+/**
+ * Decode a JSON view returned with kModeView. The view points into wasm memory and is only valid
+ * until the next call into wasm, so decode it right away.
+ */
+export const decodeJsonView = (view: Uint8Array): string => {
+    return textDecoder.decode(view);
+};
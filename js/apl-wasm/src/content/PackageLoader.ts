@@ -62,6 +62,16 @@ export class PackageLoader {
         }
     }
 
+    /**
+     * Load a single package
+     * @returns The package JSON, an empty object if it could not be loaded
+     */
+    public async fetchPackage(name: string, version: string, url?: string, domain?: string): Promise<object> {
+        await this.loadPackage(name, version, url ? url : '', domain ? domain : '');
+        const pkg: ILoadingProcessData | undefined = this.loadPackages.get(`${name}/${version}`);
+        return pkg ? pkg.json : {};
+    }
+
     /**
      * Flush loaded packages
      */
@@ -106,31 +116,36 @@ export class PackageLoader {
             if (data && data.state === LoadState.done) {
                 return Promise.resolve();
             }
+            // Wait for the download already in flight, such as a prefetch
+            return data ? data.promise : Promise.resolve();
         } else {
-            this.loadPackages.set(key, {
+            const pkg: ILoadingProcessData = {
                 state: LoadState.load,
                 json: {}
-            });
-            const pkg: ILoadingProcessData | undefined = this.loadPackages.get(key);
-
-            if (this.overridePackageLoader) {
-                // The runtime has provided their own package loader implementation
-                return this.overridePackageLoader(name, version, url, domain).then((jsonResponse) => {
-                    if (pkg) {
-                        pkg.json = JSON.parse(jsonResponse);
-                        pkg.state = LoadState.done;
-                    }
-                    return Promise.resolve();
-                }).catch((rejectionResponse) => {
-                    if (rejectionResponse) {
-                        this.logger.info(rejectionResponse);
-                    }
-                    return this.defaultDownloadBehaviour(name, version, pkg, url);
-                });
-            }
+            };
+            this.loadPackages.set(key, pkg);
+            pkg.promise = this.downloadPackage(name, version, url, domain, pkg);
+            return pkg.promise;
+        }
+    }
 
-            return this.defaultDownloadBehaviour(name, version, pkg, url);
+    private downloadPackage(name: string, version: string, url: string, domain: string,
+                            pkg: ILoadingProcessData): Promise<any> {
+        if (this.overridePackageLoader) {
+            // The runtime has provided their own package loader implementation
+            return this.overridePackageLoader(name, version, url, domain).then((jsonResponse) => {
+                pkg.json = JSON.parse(jsonResponse);
+                pkg.state = LoadState.done;
+                return Promise.resolve();
+            }).catch((rejectionResponse) => {
+                if (rejectionResponse) {
+                    this.logger.info(rejectionResponse);
+                }
+                return this.defaultDownloadBehaviour(name, version, pkg, url);
+            });
         }
+
+        return this.defaultDownloadBehaviour(name, version, pkg, url);
     }
 
     /**
@@ -202,6 +217,8 @@ export class PackageLoader {
 export interface ILoadingProcessData {
     json: object;
     state: LoadState;
+    /** Resolves once the package is done loading */
+    promise?: Promise<any>;
 }
 
 /**
@@ -5,12 +5,54 @@
 
 import { PackageLoader } from './PackageLoader';
 
+// localStorage key of the import graph observed by earlier sessions
+const IMPORT_GRAPH_STORAGE_KEY = 'apl-wasm-import-graph';
+
+export type PackageSnapshotLoader = (name: string, version: string, url?: string) => Promise<Uint8Array | undefined>;
+
 export class PackageManager {
+    private static persistedGraphLoaded: boolean = false;
+
+    /**
+     * Seed the module package cache with known import graphs.
+     * @param manifest Graph of package dependencies known ahead of time
+     * @param persisted Also load the graph saved by earlier sessions
+     */
+    public static loadImportGraph(manifest?: {[reference: string]: APL.PackageImport[]}, persisted?: boolean) {
+        if (persisted && !PackageManager.persistedGraphLoaded) {
+            PackageManager.persistedGraphLoaded = true;
+            try {
+                const saved = window.localStorage.getItem(IMPORT_GRAPH_STORAGE_KEY);
+                if (saved) {
+                    Module.PackageCache.addImportGraph(JSON.parse(saved));
+                }
+            } catch (e) {
+                // Storage unavailable or corrupted, the graph is only a hint
+            }
+        }
+        if (manifest) {
+            Module.PackageCache.addImportGraph(manifest);
+        }
+    }
+
+    /**
+     * Save the import graph known to the module package cache for later sessions.
+     */
+    public static saveImportGraph() {
+        try {
+            window.localStorage.setItem(IMPORT_GRAPH_STORAGE_KEY, JSON.stringify(Module.PackageCache.getImportGraph()));
+        } catch (e) {
+            // Storage unavailable or full, the graph is only a hint
+        }
+    }
+
     private packageLoader: PackageLoader;
     private cppPackageManager: APL.PackageManager;
+    private snapshotLoader?: PackageSnapshotLoader;
 
-    constructor(packageLoader: PackageLoader) {
+    constructor(packageLoader: PackageLoader, snapshotLoader?: PackageSnapshotLoader) {
         this.packageLoader = packageLoader;
+        this.snapshotLoader = snapshotLoader;
         this.cppPackageManager = Module.PackageManager.create((
             importRequest: APL.ImportRequest
         ) => {
@@ -27,18 +69,55 @@ export class PackageManager {
         this.cppPackageManager.destroy();
     }
 
+    /**
+     * Fetch in parallel every nested import of the content known from the import graph, so core
+     * finds them in the package cache instead of requesting them one layer at a time.
+     */
+    public async prefetch(content: APL.Content): Promise<void> {
+        const imports = content.getPrefetchImports();
+        await Promise.all(imports.map(async (packageImport) => {
+            if (await this.importSnapshot(packageImport.reference, packageImport.name,
+                    packageImport.version, packageImport.source)) {
+                return;
+            }
+            const json = await this.packageLoader.fetchPackage(
+                packageImport.name, packageImport.version, packageImport.source);
+            if (Object.keys(json).length > 0) {
+                Module.PackageCache.addPackage(packageImport.reference, JSON.stringify(json));
+            }
+        }));
+    }
+
     public async importPackage(request: APL.ImportRequest) {
+        const ref = request.reference();
+        if (await this.importSnapshot(Module.PackageCache.getKey(request), ref.name(), ref.version(),
+                request.source())) {
+            return;
+        }
+
         const loadedPackages = await this.packageLoader.load([request]);
 
         // We only receive one ImportRequest at a time. Nested package imports are resolved as
         // individual requests by Core. Therefore: we expect one package download at a time.
         if (loadedPackages.length === 1 && Object.keys(loadedPackages[0].json).length > 0) {
-            this.cppPackageManager.importPackageSucceeded(
-                request.reference().toString(),
-                JSON.stringify(loadedPackages[0].json)
-            );
+            this.cppPackageManager.importPackageSucceeded(request, JSON.stringify(loadedPackages[0].json));
         } else {
-            this.cppPackageManager.importPackageFailed(request.reference().toString(), '', -1);
+            this.cppPackageManager.importPackageFailed(request, '', -1);
+        }
+    }
+
+    /**
+     * @returns True if the package was imported from its snapshot
+     */
+    private async importSnapshot(reference: string, name: string, version: string, url?: string): Promise<boolean> {
+        if (!this.snapshotLoader) {
+            return false;
+        }
+        try {
+            const snapshot = await this.snapshotLoader(name, version, url);
+            return snapshot !== undefined && Module.PackageCache.addPackageSnapshot(reference, snapshot);
+        } catch (e) {
+            return false;
         }
     }
 }
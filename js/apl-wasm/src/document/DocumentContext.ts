@@ -111,7 +111,7 @@ export class DocumentContext {
         this.rootConfig.mediaPlayerFactory(this.mediaPlayerFactory);
 
         this.packageLoader = new PackageLoader(vhConfig.packageLoader);
-        this.packageManager = new PackageManager(this.packageLoader);
+        this.packageManager = new PackageManager(this.packageLoader, vhConfig.packageSnapshotLoader);
         this.rootConfig.packageManager(this.packageManager.getCppPackageManager());
 
         this.documentManager = new DocumentManager(vhContext, request.embeddedDocumentFactory);
@@ -363,6 +363,26 @@ export class DocumentContext {
         return this.aplRenderer.processDataSourceUpdate(payload, type);
     }
 
+    /**
+     * @internal
+     * @ignore
+     */
+    public async updateDataSources(updates: APL.DataSourceUpdate[]): Promise<boolean[]> {
+        if (!this.aplRenderer) {
+            return Promise.reject('Context destroyed');
+        }
+        if (this.aplRenderer.getDocumentState() !== DocumentState.displayed) {
+            return Promise.reject('Document not rendered');
+        }
+
+        if (this.documentConfig) {
+            // Embedded Doc use case
+            return updates.map((update) => this.documentConfig.processDataSourceUpdate(
+                update.type ? update.type : 'dynamicIndexList', update.payload));
+        }
+        return this.aplRenderer.processDataSourceUpdates(updates);
+    }
+
     /**
      * @internal
      * @ignore
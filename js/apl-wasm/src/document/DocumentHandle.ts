@@ -81,6 +81,15 @@ export class DocumentHandle {
         return this.delegate!.updateDataSource(payload, type);
     }
 
+    /**
+     * Update the data sources of the document with several payloads at once, in a single frame
+     * @param updates data source update commands, the type defaulting to dynamicIndexList
+     * @returns for each update, true for success, false for failure.
+     */
+    public async updateDataSources(updates: APL.DataSourceUpdate[]): Promise<boolean[]> {
+        return this.delegate!.updateDataSources(updates);
+    }
+
     /**
      * Add a IDocumentLifecycleListener to the document.
      * @param listener IDocumentLifecycleListener
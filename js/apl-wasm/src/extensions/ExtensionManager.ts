@@ -14,6 +14,8 @@ import { ExtensionClient, IExtensionClient } from './ExtentionClient';
  */
 export class ExtensionManager implements IExtensionManager {
     public rootContext: APL.Context | undefined;
+    /// Wakes up the renderer frame loop once a message has been applied to the root context.
+    public requestFrame: (() => void) | undefined;
     /// Logger to be used for this component logs.
     protected logger: ILogger;
     private extensions: Map<string, IExtension>;
@@ -107,6 +109,9 @@ export class ExtensionManager implements IExtensionManager {
         const extensionClient = this.extensionClients.get(uri);
         if (extensionClient) {
             extensionClient.processMessage(this.rootContext === undefined ? null : this.rootContext, payload);
+            if (this.requestFrame) {
+                this.requestFrame();
+            }
         }
     }
 
@@ -121,6 +126,7 @@ export class ExtensionManager implements IExtensionManager {
 
     public resetRootContext(): void {
         this.rootContext = undefined;
+        this.requestFrame = undefined;
     }
 
     private registerBuildInExtensions(extension: IExtension,
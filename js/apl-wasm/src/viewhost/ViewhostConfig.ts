@@ -72,6 +72,11 @@ export interface IAPLViewhostConfig {
     extensionManager?: ExtensionManager;
     /** Override package download. Reject the Promise to fallback to the default logic. */
     packageLoader?: (name: string, version: string, url?: string, domain?: string) => Promise<string>;
+    /**
+     * Load the binary snapshot of a package, built by the apl-snapshot tool, which skips JSON parsing.
+     * Resolve to undefined, or to a snapshot that is rejected, to fall back to the JSON package.
+     */
+    packageSnapshotLoader?: (name: string, version: string, url?: string) => Promise<Uint8Array | undefined>;
     /** callback for APL Log Command handling, will overwrite the callback used in Content creation */
     onLogCommand?: (level: number, message: string, args: object) => void;
     /** Skip force loading of fonts loading. For tests mainly as electron flacky with it. */
@@ -46,10 +46,14 @@ public:
     void play(ActionRef actionRef) override;
     void pause() override;
 
+    /**
+     * @return True while a play request is pending.
+     */
+    bool isActive() const;
+
 private:
     void resolveExistingAction();
     void doPlayerCallback(apl::AudioPlayerEventType eventType, bool paused, bool ended, apl::TrackState trackState);
-    bool isActive() const;
 
 private:
     emscripten::val mPlayer = emscripten::val::null();
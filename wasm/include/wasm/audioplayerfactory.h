@@ -36,6 +36,11 @@ public:
      */
     void tick();
 
+    /**
+     * @return True while any created player is playing, so time updates are still needed.
+     */
+    bool isActive() const;
+
     /**
      * Clear existing players.
      */
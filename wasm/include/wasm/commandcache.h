@@ -0,0 +1,131 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_COMMANDCACHE_H
+#define APL_WASM_COMMANDCACHE_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+
+namespace apl {
+namespace wasm {
+
+class CommandDocument;
+using CommandDocumentPtr = std::shared_ptr<CommandDocument>;
+
+/**
+ * A parsed command payload. The document lives in a MemoryPoolAllocator whose first chunk is
+ * taken from a pool of reusable buffers, so small payloads parse without touching the heap.
+ */
+class CommandDocument {
+public:
+    static const size_t POOL_BUFFER_SIZE = 4096;
+
+    /**
+     * @param json The JSON payload
+     * @return The parsed document. A payload that does not parse yields a null value.
+     */
+    static CommandDocumentPtr parse(const std::string& json);
+
+    /**
+     * @param value The value to deep copy
+     * @return A document holding a copy of the value
+     */
+    static CommandDocumentPtr copy(const rapidjson::Value& value);
+
+    CommandDocument();
+
+    const rapidjson::Value& value() const { return mDocument; }
+    rapidjson::Document& document() { return mDocument; }
+    bool hasParseError() const { return mDocument.HasParseError(); }
+
+    /**
+     * @return The number of buffers waiting in the pool
+     */
+    static size_t pooledBufferCount();
+
+private:
+    /**
+     * Owns the first allocator chunk and returns it to the pool. Declared first, so it is
+     * destroyed after the allocator that points into it.
+     */
+    class PooledBuffer {
+    public:
+        PooledBuffer();
+        ~PooledBuffer();
+        char* data() { return mData.get(); }
+
+    private:
+        std::unique_ptr<char[]> mData;
+    };
+
+    PooledBuffer mBuffer;
+    rapidjson::MemoryPoolAllocator<> mAllocator;
+    rapidjson::Document mDocument;
+};
+
+/**
+ * Parsed command payloads shared by every context of the module.
+ *
+ * Skills tend to send the same few command arrays over and over, so payloads up to
+ * MAX_CACHED_PAYLOAD bytes are kept, parsed and immutable, in a small LRU keyed by the payload
+ * hash. Larger payloads are parsed on every call.
+ *
+ * Templates are command payloads registered once under a name. String values of the form
+ * "{{name}}" are placeholders, replaced by the matching argument when the template runs, which
+ * copies the parsed template instead of parsing a new payload.
+ */
+class CommandCache {
+public:
+    static const size_t DEFAULT_CAPACITY = 32;
+    static const size_t MAX_CACHED_PAYLOAD = 8192;
+
+    /**
+     * @param payload The JSON payload
+     * @return The parsed payload, from the cache when possible
+     */
+    static CommandDocumentPtr get(const std::string& payload);
+
+    /**
+     * Keep a document alive until the action that executes it has finished.
+     */
+    static void retain(const ActionPtr& action, const CommandDocumentPtr& document);
+
+    /**
+     * Register or replace a command template.
+     * @param name The template name
+     * @param commands The command payload, with "{{argument}}" placeholders
+     * @return True if the payload parsed
+     */
+    static bool registerTemplate(const std::string& name, const std::string& commands);
+
+    static bool unregisterTemplate(const std::string& name);
+
+    /**
+     * Build the commands of a template.
+     * @param name The template name
+     * @param arguments Object holding the value of each placeholder
+     * @return The commands, or nullptr if no template has that name
+     */
+    static CommandDocumentPtr instantiate(const std::string& name, emscripten::val arguments);
+
+    /**
+     * Drop the cached payloads. Templates are kept.
+     */
+    static void clear();
+
+    static void setCapacity(size_t capacity);
+
+    /**
+     * @return Object holding the "hits", "misses", "entries", "templates" and "pooledBuffers" counts
+     */
+    static emscripten::val getStats();
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_COMMANDCACHE_H
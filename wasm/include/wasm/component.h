@@ -20,6 +20,8 @@ struct ComponentMethods {
     static emscripten::val getDirtyProps(apl::ComponentPtr& component);
     static emscripten::val getCalculated(const apl::ComponentPtr& component);
     static emscripten::val getCalculatedByKey(const apl::ComponentPtr& component, int key);
+    static double getCalculatedNumber(const apl::ComponentPtr& component, int key);
+    static uint32_t getCalculatedColor(const apl::ComponentPtr& component, int key);
     static int getType(const apl::ComponentPtr& component);
     static std::string getUniqueId(const apl::ComponentPtr& component);
     static std::string getId(const apl::ComponentPtr& component);
@@ -56,6 +58,24 @@ struct ComponentMethods {
     static std::string provenance(const apl::ComponentPtr& component);
 
     static MediaPlayerPtr getMediaPlayer(const apl::ComponentPtr& component);
+
+    /**
+     * Number of Int32 entries per node in the snapshotSubtree "nodes" array:
+     * parent index, depth, type, displayed child count, index of the first child.
+     */
+    static const int SNAPSHOT_NODE_SIZE = 5;
+
+    /**
+     * Serialize the displayed hierarchy below a component in one call. Nodes are listed breadth
+     * first, so the children of a node are contiguous and start at its first child index.
+     * @param component The root of the snapshot, node 0
+     * @param maxDepth Depth of the deepest nodes included, negative for the whole subtree. Nodes at
+     *                 the limit report no children; a snapshot of such a node goes further down.
+     * @return Object holding "count", the "nodes" Int32Array and the per node "components",
+     *         "uniqueIds", "ids" and "props" arrays. The component of node 0 is null, the caller
+     *         already holds it.
+     */
+    static emscripten::val snapshotSubtree(const apl::ComponentPtr& component, int maxDepth);
 };
 } // namespace internal
 
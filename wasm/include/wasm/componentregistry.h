@@ -0,0 +1,96 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_COMPONENTREGISTRY_H
+#define APL_WASM_COMPONENTREGISTRY_H
+
+#include "apl/apl.h"
+#include <unordered_map>
+#include <vector>
+
+namespace apl {
+namespace wasm {
+
+class WASMMetrics;
+
+/**
+ * Dense integer handles for the components of one root context, so the viewhost can walk and
+ * query the component tree without an embind wrapper or a uniqueId string per component.
+ *
+ * The registry only holds weak references: a handle never keeps its component alive. A handle is
+ * a slot index tagged with the generation of the slot, which is bumped every time the slot is
+ * released, so a stale handle never resolves to the component that reused its slot.
+ *
+ * Destroyed components are found by checking a bounded number of slots per collectReleased()
+ * call, and by a full sweep when the registry runs out of free slots and has doubled since the
+ * last sweep, so neither registering nor collecting scans the whole registry every frame.
+ */
+class ComponentRegistry {
+public:
+    static const int INVALID_HANDLE = -1;
+    // Bits of a handle holding the slot index, the generation takes the remaining bits
+    static const int SLOT_BITS = 20;
+    static const int MAX_SLOTS = 1 << SLOT_BITS;
+    static const unsigned GENERATION_MASK = (1u << (31 - SLOT_BITS)) - 1;
+    // Slots allocated before the first sweep
+    static const size_t MIN_SWEEP_SIZE = 64;
+    // Slots checked for destroyed components by each collectReleased() call
+    static const size_t RELEASE_SCAN_SIZE = 256;
+
+    /**
+     * @param metrics Metrics of the root context, set as user data of every registered component
+     */
+    explicit ComponentRegistry(WASMMetrics* metrics) : mMetrics(metrics) {}
+
+    /**
+     * @param component The component
+     * @return The handle of the component, registering it if needed. INVALID_HANDLE for nullptr.
+     */
+    int handleFor(const ComponentPtr& component);
+
+    /**
+     * @param handle The handle
+     * @return The component, or nullptr if the handle is unknown or the component was destroyed
+     */
+    ComponentPtr get(int handle) const;
+
+    /**
+     * Release the handles of destroyed components found since the last call.
+     * @return The released handles, with the generation they had while their component was alive
+     */
+    std::vector<int> collectReleased();
+
+    /**
+     * @return The number of registered components that are still alive
+     */
+    size_t size() const { return mIndex.size(); }
+
+private:
+    struct Slot {
+        std::weak_ptr<Component> component;
+        const Component* address = nullptr;
+        unsigned generation = 0;
+    };
+
+    static int toHandle(int slot, unsigned generation) {
+        return slot | static_cast<int>((generation & GENERATION_MASK) << SLOT_BITS);
+    }
+
+    void release(int slot);
+    void sweep();
+
+    WASMMetrics* mMetrics;
+    std::vector<Slot> mSlots;
+    std::unordered_map<const Component*, int> mIndex;
+    std::vector<int> mFree;
+    std::vector<int> mReleased;
+    size_t mSweepSize = MIN_SWEEP_SIZE;
+    size_t mScanPosition = 0;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_COMPONENTREGISTRY_H
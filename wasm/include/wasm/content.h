@@ -19,14 +19,53 @@ struct ContentMethods {
     static apl::ContentPtr create(const std::string& document, const SessionPtr& session);
     static apl::ContentPtr createWithConfig(const std::string& document, const SessionPtr& session,
                                             const Metrics& metrics, const RootConfig& config);
+    /**
+     * Create the content from a JsonBuffer, parsed in situ and taken over.
+     * @return The content, or nullptr for an unknown buffer or a document that does not parse
+     */
+    static apl::ContentPtr createFromBuffer(uintptr_t document, size_t length, const SessionPtr& session);
+    static apl::ContentPtr createFromBufferWithConfig(uintptr_t document, size_t length, const SessionPtr& session,
+                                                      const Metrics& metrics, const RootConfig& config);
+    /**
+     * Create the content from a JsonBuffer holding gzip or zlib compressed JSON, see JsonBuffer::parseCompressed.
+     */
+    static apl::ContentPtr createFromCompressedBuffer(uintptr_t document, size_t length, const SessionPtr& session);
+    static apl::ContentPtr createFromCompressedBufferWithConfig(uintptr_t document, size_t length,
+                                                                const SessionPtr& session, const Metrics& metrics,
+                                                                const RootConfig& config);
     static void refresh(const apl::ContentPtr& content, const Metrics& metrics, const RootConfig& config);
     static void load(const apl::ContentPtr& content, emscripten::val onSuccess, emscripten::val onFailure);
     static std::set<apl::ImportRequest> getRequestedPackages(const apl::ContentPtr& content);
+    /**
+     * @return The nested imports of the requested packages that the package cache knows about and
+     *         does not hold yet, as {reference, name, version, source} objects
+     */
+    static emscripten::val getPrefetchImports(const apl::ContentPtr& content);
     static bool isError(const apl::ContentPtr& content);
     static bool isReady(const apl::ContentPtr& content);
     static bool isWaiting(const apl::ContentPtr& content);
     static void addData(const apl::ContentPtr& content, const std::string& name, const std::string& data);
     static void addPackage(const apl::ContentPtr& content, const apl::ImportRequest& request, const std::string& data);
+    /**
+     * Add data or a package from a JsonBuffer, parsed in situ and taken over. A buffer that cannot
+     * be read still answers the parameter or package, with empty data, so core reports the error
+     * instead of waiting for it forever.
+     * @return True if the data parsed
+     */
+    static bool addDataFromBuffer(const apl::ContentPtr& content, const std::string& name, uintptr_t data,
+                                  size_t length);
+    static bool addPackageFromBuffer(const apl::ContentPtr& content, const apl::ImportRequest& request,
+                                     uintptr_t data, size_t length);
+    static bool addDataFromCompressedBuffer(const apl::ContentPtr& content, const std::string& name, uintptr_t data,
+                                            size_t length);
+    static bool addPackageFromCompressedBuffer(const apl::ContentPtr& content, const apl::ImportRequest& request,
+                                               uintptr_t data, size_t length);
+    /**
+     * Add the data sources of another content, sharing their parsed documents. Parameters without
+     * data are resolved from the members of the payload data source.
+     * @return Array of the names of the data sources added
+     */
+    static emscripten::val copyData(const apl::ContentPtr& content, const apl::ContentPtr& other);
     static std::string getAPLVersion(const apl::ContentPtr& content);
     static std::set<std::string> getExtensionRequests(const apl::ContentPtr& content);
     static emscripten::val getExtensionSettings(const apl::ContentPtr& content, const std::string& extensionName);
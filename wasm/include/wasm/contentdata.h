@@ -0,0 +1,60 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_CONTENTDATA_H
+#define APL_WASM_CONTENTDATA_H
+
+#include "apl/apl.h"
+#include <rapidjson/document.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * The data sources added to each content, in the order they were added.
+ *
+ * Data is parsed in wasm and handed to core as JsonData, which shares the parsed document. Core
+ * keeps the data of a content for as long as the content may be inflated, so only weak references
+ * are kept here: a data source costs nothing more than what core already holds, and a content can
+ * be recreated from the same documents without parsing again or the viewhost holding on to the
+ * raw data.
+ */
+class ContentData {
+public:
+    typedef std::vector<std::pair<std::string, std::shared_ptr<rapidjson::Document>>> DataList;
+
+    /**
+     * Add a parsed data source to a content and record it.
+     * @param content The content
+     * @param name The name of the data source
+     * @param data The parsed data
+     */
+    static void add(const ContentPtr& content, const std::string& name,
+                    const std::shared_ptr<rapidjson::Document>& data);
+
+    /**
+     * @return The data sources of a content that are still held by core
+     */
+    static DataList get(const ContentPtr& content);
+
+    /**
+     * Add the data sources of a content to another one. Main template parameters with no data of
+     * their own are then given the member of the same name of the payload data source, if any,
+     * as when a content is created from a single data document.
+     * @param content The content to add the data to
+     * @param other The content the data was added to
+     * @return The names of the data sources added
+     */
+    static std::vector<std::string> copy(const ContentPtr& content, const ContentPtr& other);
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_CONTENTDATA_H
@@ -12,6 +12,8 @@
 namespace apl {
 namespace wasm {
 
+class WasmTextMeasurement;
+
 namespace internal {
 
 static std::map<std::string, ViewportMode> modeMap = {
@@ -24,28 +26,64 @@ static std::map<std::string, ViewportMode> modeMap = {
 
 struct ContextMethods {
     static apl::RootContextPtr create(emscripten::val options, emscripten::val text, emscripten::val metrics, emscripten::val content, emscripten::val config, emscripten::val scalingOptions);
+    static void destroy(const apl::RootContextPtr& context);
 
     static apl::ComponentPtr topComponent(const apl::RootContextPtr& context);
     static apl::DocumentContextPtr topDocument(const apl::RootContextPtr& context);
+    static int getComponentHandle(const apl::RootContextPtr& context, const apl::ComponentPtr& component);
+    static int getTopComponentHandle(const apl::RootContextPtr& context);
+    static apl::ComponentPtr getComponentByHandle(const apl::RootContextPtr& context, int handle);
+    static int getParentHandle(const apl::RootContextPtr& context, int handle);
+    static emscripten::val getChildHandles(const apl::RootContextPtr& context, int handle);
+    static emscripten::val getDisplayedChildHandles(const apl::RootContextPtr& context, int handle);
+    static emscripten::val getComponentTypes(const apl::RootContextPtr& context, emscripten::val handles);
+    static emscripten::val getGlobalBoundsForHandles(const apl::RootContextPtr& context, emscripten::val handles);
+    static emscripten::val getCalculatedForHandles(const apl::RootContextPtr& context, emscripten::val handles, int key);
+    static emscripten::val collectReleasedHandles(const apl::RootContextPtr& context);
     static emscripten::val getBackground(const apl::RootContextPtr& context);
     static void setBackground(const apl::RootContextPtr& context, emscripten::val background);
     static std::string getDocumentState(const apl::RootContextPtr& context);
     static std::string getDataSourceContext(const apl::RootContextPtr& context);
     static std::string getVisualContext(const apl::RootContextPtr& context);
+
+    /**
+     * Serialized state without the intermediate std::string.
+     * @param mode A JsonBridge::Mode
+     * @return JSON string, Uint8Array view of UTF-8 JSON to decode right away, or JS object
+     */
+    static emscripten::val getDocumentStateAs(const apl::RootContextPtr& context, int mode);
+    static emscripten::val getDataSourceContextAs(const apl::RootContextPtr& context, int mode);
+    static emscripten::val getVisualContextAs(const apl::RootContextPtr& context, int mode);
     static void clearPending(const apl::RootContextPtr& context);
     static bool isDirty(const apl::RootContextPtr& context);
     static void clearDirty(const apl::RootContextPtr& context);
     static emscripten::val getDirty(const apl::RootContextPtr& context);
+    static emscripten::val collectFrameDelta(const apl::RootContextPtr& context);
     static emscripten::val getPendingErrors(const apl::RootContextPtr& context);
     static bool hasEvent(const apl::RootContextPtr& context);
     static apl::Event popEvent(const apl::RootContextPtr& context);
+
+    /**
+     * Pop every pending event, already converted for the viewhost.
+     * @return Array of decoded events, see EventMethods::decode. Events waiting on the viewhost
+     *         carry a token for resolveEvent; the others carry EventRegistry::INVALID_TOKEN.
+     */
+    static emscripten::val drainEvents(const apl::RootContextPtr& context);
+    static void resolveEvent(const apl::RootContextPtr& context, int token);
+    static void resolveEventWithArg(const apl::RootContextPtr& context, int token, int argument);
+    static void resolveEventWithRect(const apl::RootContextPtr& context, int token, int x, int y, int width, int height);
+    static void addEventTerminateCallback(const apl::RootContextPtr& context, int token, emscripten::val callback);
     static bool screenLock(const apl::RootContextPtr& context);
     static apl_time_t currentTime(const apl::RootContextPtr& context);
     static apl_time_t nextTime(const apl::RootContextPtr& context);
     static void scrollToRectInComponent(const apl::RootContextPtr& context, const apl::ComponentPtr& component, int x, int y, int width, int height, int align);
     static void updateTime(const apl::RootContextPtr& context, apl_time_t currentTime, apl_time_t utcTime);
     static void setLocalTimeAdjustment(const apl::RootContextPtr& context, apl_duration_t offset);
+    static emscripten::val tick(const apl::RootContextPtr& context, apl_time_t currentTime, apl_time_t utcTime, apl_duration_t offset);
+    static emscripten::val collectFrame(const apl::RootContextPtr& context);
+    static bool hasPendingWork(const apl::RootContextPtr& context);
     static apl::ActionPtr executeCommands(const apl::RootContextPtr& context, const std::string& commands);
+    static apl::ActionPtr executeCommandTemplate(const apl::RootContextPtr& context, const std::string& name, emscripten::val arguments);
     static apl::ActionPtr invokeExtensionEventHandler(const apl::RootContextPtr& context, const std::string& uri, const std::string& name, const std::string& data, bool fastMode);
     static void cancelExecution(const apl::RootContextPtr& context);
     static emscripten::val getViewportPixelSize(const apl::RootContextPtr& context);
@@ -54,10 +92,58 @@ struct ContextMethods {
     static double getScaleFactor(const apl::RootContextPtr& context);
     static void updateCursorPosition(const apl::RootContextPtr& context, float x, float y);
     static bool handlePointerEvent(const apl::RootContextPtr& context, int pointerEventType, float x, float y, int pointerId, int pointerType);
+
+    /**
+     * Number of doubles per event in a handlePointerEvents batch: type, x, y, pointer id, pointer type.
+     */
+    static const size_t POINTER_EVENT_SIZE = 5;
+
+    /**
+     * Handle a batch of pointer events. Consecutive moves of the same pointer are coalesced into
+     * the last one before they reach core.
+     * @param events Float32Array of packed events, POINTER_EVENT_SIZE entries each
+     * @return Uint8Array with the consumed flag of every event in the batch
+     */
+    static emscripten::val handlePointerEvents(const apl::RootContextPtr& context, emscripten::val events);
     static bool handleKeyboard(const apl::RootContextPtr& context, int type, const emscripten::val& keyboard);
+
+    /**
+     * Handle a key event given as KeyTable ids.
+     * @param type The KeyHandlerType
+     * @param codeId KeyTable id of KeyboardEvent.code
+     * @param keyId KeyTable id of KeyboardEvent.key
+     * @param modifiers Bitmask of KeyTable::Modifier values
+     */
+    static bool handleKeyboardCode(const apl::RootContextPtr& context, int type, int codeId, int keyId, int modifiers);
+
+    /**
+     * Number of ints per event in a handleKeyboardSequence batch: type, code id, key id, modifiers.
+     */
+    static const size_t KEYBOARD_EVENT_SIZE = 4;
+
+    /**
+     * Handle a burst of key events, such as the repeats of a held remote control key, in order.
+     * @param events Int32Array of packed events, KEYBOARD_EVENT_SIZE entries each
+     * @return Uint8Array with the consumed flag of every event in the sequence
+     */
+    static emscripten::val handleKeyboardSequence(const apl::RootContextPtr& context, emscripten::val events);
     static bool processDataSourceUpdate(const apl::RootContextPtr& context, const std::string& payload, const std::string& type);
+    /**
+     * Apply several data source updates in one call, ahead of the next frame.
+     * @param updates Array of {type, payload} objects, the type defaulting to dynamicIndexList
+     * @return Uint8Array with 1 for each update that was processed
+     */
+    static emscripten::val processDataSourceUpdates(const apl::RootContextPtr& context, emscripten::val updates);
+    /**
+     * Size a data source fetch request with the fetch window of the context, see FetchWindow.
+     * @return The payload to send, or null if the request is already covered by one in flight
+     */
+    static emscripten::val adjustFetchRequest(const apl::RootContextPtr& context, const std::string& type, emscripten::val payload);
     static void handleDisplayMetrics(const apl::RootContextPtr& context, emscripten::val metrics);
     static void configurationChange(const apl::RootContextPtr& context, emscripten::val configurationChange, emscripten::val metrics, emscripten::val scalingOptions);
+    static emscripten::val getTextMeasurementCacheStats(const apl::RootContextPtr& context);
+    static void setTextMeasurementCacheBudget(const apl::RootContextPtr& context, double byteBudget);
+    static void clearTextMeasurementCache(const apl::RootContextPtr& context);
     static void updateDisplayState(const apl::RootContextPtr& context, int displayState);
     static void reInflate(const apl::RootContextPtr& context);
     static void setFocus(const apl::RootContextPtr& context, int direction, const apl::Rect& origin, const std::string& targetId);
@@ -67,6 +153,8 @@ struct ContextMethods {
     static void mediaLoadFailed(const apl::RootContextPtr& context, const std::string& source, int errorCode, const std::string& error);
 
 private:
+    static apl::Object collectPendingErrors(const apl::RootContextPtr& context);
+    static std::shared_ptr<WasmTextMeasurement> getTextMeasurement(const apl::RootContextPtr& context);
     static void applyScalingOptions(emscripten::val& scalingOptions,
                                     std::vector<ViewportSpecification>& specs,
                                     Metrics& coreMetrics,
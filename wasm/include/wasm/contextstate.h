@@ -0,0 +1,116 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_CONTEXTSTATE_H
+#define APL_WASM_CONTEXTSTATE_H
+
+#include "apl/apl.h"
+#include "wasm/componentregistry.h"
+#include "wasm/eventregistry.h"
+#include "wasm/fetchwindow.h"
+#include "wasm/framedelta.h"
+#include "wasm/wasmmetrics.h"
+#include <emscripten/bind.h>
+
+namespace apl {
+namespace wasm {
+
+class WasmTextMeasurement;
+
+/**
+ * Binding state of a single RootContext: its metrics, document background, text measurer,
+ * component handles, event tokens and frame buffers. Several documents can share one module instance because nothing here is global.
+ *
+ * The state is registered when the root context is created and released when the viewhost
+ * destroys the context, or once the root context is gone if it never does. The root context user
+ * data keeps pointing at the metrics, so components, events and graphics keep resolving them the
+ * way they always have. Those objects can outlive the root context through their JS wrappers, so
+ * the metrics of a released state live on until the root context and the data contexts of every
+ * component tree handed to the viewhost are gone: each component keeps its tree's context alive.
+ */
+class ContextState {
+public:
+    /**
+     * Register the state of a newly created root context.
+     * @param context The root context
+     * @param metrics Metrics owned by the state
+     * @param textMeasurement The DOM text measurer of the context, if any
+     * @return The registered state
+     */
+    static ContextState& create(const RootContextPtr& context,
+                                std::unique_ptr<WASMMetrics> metrics,
+                                const std::shared_ptr<WasmTextMeasurement>& textMeasurement);
+
+    /**
+     * @return The state of the root context, or nullptr if it was not created by Context.create.
+     */
+    static ContextState* get(const RootContextPtr& context);
+
+    /**
+     * @return The state owning the metrics, or nullptr. Resolves the context of objects that only
+     *         carry the metrics as user data, such as events.
+     */
+    static ContextState* find(const WASMMetrics* metrics);
+
+    /**
+     * Release the state of a root context the viewhost is done with.
+     */
+    static void release(const RootContextPtr& context);
+
+    /**
+     * Release the state of every root context that has been destroyed.
+     */
+    static void releaseExpired();
+
+    WASMMetrics* getMetrics() const { return mMetrics.get(); }
+
+    /**
+     * Keep the metrics alive for as long as a component of the tree of this top component is.
+     * @param top A top component handed to the viewhost
+     */
+    void retainTree(const ComponentPtr& top);
+
+    /**
+     * Update the metrics in place. Components, events and graphics keep a pointer to the metrics,
+     * so the instance owned by the state is never replaced.
+     */
+    void updateMetrics(const WASMMetrics& metrics) { *mMetrics = metrics; }
+
+    emscripten::val& getBackground() { return mBackground; }
+    void setBackground(const emscripten::val& background) { mBackground = background; }
+
+    FrameDelta& getFrameDelta() { return mFrameDelta; }
+
+    ComponentRegistry& getComponents() { return *mComponents; }
+
+    EventRegistry& getEvents() { return mEvents; }
+
+    /**
+     * With decoded events, tick() returns the events of a frame as drainEvents() does.
+     */
+    bool getDecodeEvents() const { return mDecodeEvents; }
+    void setDecodeEvents(bool decodeEvents) { mDecodeEvents = decodeEvents; }
+
+    FetchWindow& getFetchWindow() { return mFetchWindow; }
+
+    const std::shared_ptr<WasmTextMeasurement>& getTextMeasurement() const { return mTextMeasurement; }
+
+private:
+    std::weak_ptr<RootContext> mContext;
+    std::unique_ptr<WASMMetrics> mMetrics;
+    std::vector<std::weak_ptr<Context>> mTrees;
+    std::shared_ptr<WasmTextMeasurement> mTextMeasurement;
+    std::unique_ptr<ComponentRegistry> mComponents;
+    EventRegistry mEvents;
+    bool mDecodeEvents = false;
+    FetchWindow mFetchWindow;
+    emscripten::val mBackground = emscripten::val::object();
+    FrameDelta mFrameDelta;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_CONTEXTSTATE_H
@@ -0,0 +1,82 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_DATASOURCESTREAM_H
+#define APL_WASM_DATASOURCESTREAM_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+
+namespace apl {
+namespace wasm {
+
+class DataSourceStream;
+using DataSourceStreamPtr = std::shared_ptr<DataSourceStream>;
+
+/**
+ * Parses a data source of a content as its chunks arrive, instead of parsing the whole payload
+ * in one call once it has been downloaded.
+ *
+ * Each chunk is scanned for the structural characters outside of strings, and rapidjson's
+ * iterative reader runs up to the last point where the next token is known to be complete. The
+ * remaining bytes wait for the next chunk, and parsed bytes are dropped. When the stream ends, the
+ * data source is added to the content.
+ */
+class DataSourceStream {
+public:
+    /**
+     * @param content The content waiting for the data source
+     * @param name The name of the data source
+     */
+    static DataSourceStreamPtr create(const apl::ContentPtr& content, const std::string& name);
+
+    DataSourceStream(const apl::ContentPtr& content, const std::string& name);
+
+    /**
+     * Parse a chunk, as far as it is complete.
+     * @param chunk Uint8Array holding the next UTF-8 bytes of the data source
+     * @return False once the data source has failed to parse
+     */
+    bool write(emscripten::val chunk);
+
+    /**
+     * Parse the rest of the data source and add it to the content.
+     * @return True if the data source parsed and was added
+     */
+    bool end();
+
+    /**
+     * @return Number of bytes parsed so far
+     */
+    size_t getParsedBytes() const { return mBase; }
+
+    bool hasError() const { return mFailed; }
+
+private:
+    struct ChunkStream;
+
+    void scan(size_t from);
+    bool parse(bool all);
+
+    apl::ContentPtr mContent;
+    std::string mName;
+    std::shared_ptr<rapidjson::Document> mDocument;
+    rapidjson::Reader mReader;
+    std::vector<char> mPending;
+    size_t mBase = 0;           // Offset of the first pending byte in the data source
+    size_t mStructural[2];      // Offsets of the last two structural characters outside of strings
+    int mStructuralCount = 0;
+    bool mInString = false;
+    bool mEscape = false;
+    bool mFailed = false;
+    bool mEnded = false;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_DATASOURCESTREAM_H
@@ -15,11 +15,15 @@ struct DocumentContextMethods {
     static bool isVisualContextDirty(const apl::DocumentContextPtr& context);
     static void clearVisualContextDirty(const apl::DocumentContextPtr& context);
     static std::string getVisualContext(const apl::DocumentContextPtr& context);
+    static emscripten::val getVisualContextAs(const apl::DocumentContextPtr& context, int mode);
     static bool isDataSourceContextDirty(const apl::DocumentContextPtr& context);
     static void clearDataSourceContextDirty(const apl::DocumentContextPtr& context);
     static std::string getDataSourceContext(const apl::DocumentContextPtr& context);
+    static emscripten::val getDataSourceContextAs(const apl::DocumentContextPtr& context, int mode);
     static apl::ContentPtr& content(const apl::DocumentContextPtr& context);
     static apl::ActionPtr executeCommands(const apl::DocumentContextPtr& context, const std::string& commands, bool fastMode);
+    static apl::ActionPtr executeCommandTemplate(const apl::DocumentContextPtr& context, const std::string& name,
+                                                 emscripten::val arguments, bool fastMode);
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include "apl/apl.h"
 #include "wasmmetrics.h"
+#include "wasm/propertyconversion.h"
 #include <emscripten/bind.h>
 #include <set>
 #include <utility>
@@ -36,6 +37,36 @@ iterateProps(const apl::CalculatedPropertyMap& calculated, emscripten::val& map,
 emscripten::val
 getValFromObject(const apl::Object& obj, WASMMetrics* metrics);
 
+/**
+ * Converts an apl::Object whose conversion kind is already known into an emscripten value.
+ * @param obj The Object to convert
+ * @param kind The conversion kind of the Object
+ * @param metrics Metrics for transforming dimensions to and from core to viewhost
+ * @return The emscripten value
+ */
+emscripten::val
+getValFromObject(const apl::Object& obj, apl::wasm::ConversionKind kind, WASMMetrics* metrics);
+
+/**
+ * Converts the value of a component property into an emscripten value, using the conversion
+ * kind recorded for the property instead of testing every type.
+ * @param key The property key
+ * @param obj The calculated value of the property
+ * @param metrics Metrics for transforming dimensions to and from core to viewhost
+ * @return The emscripten value
+ */
+emscripten::val
+getValFromProperty(apl::PropertyKey key, const apl::Object& obj, WASMMetrics* metrics);
+
+/**
+ * Converts a number or absolute dimension into a double, without allocating an emscripten value.
+ * @param obj The Object to convert
+ * @param metrics Metrics for transforming dimensions to and from core to viewhost
+ * @return The number, the dimension in viewhost pixels or NaN for any other type
+ */
+double
+getNumberFromProperty(const apl::Object& obj, WASMMetrics* metrics);
+
 /**
  * Converts an apl::ObjectMap into an emscripten::object. Works with deeply nested
  * Objects.
@@ -114,6 +145,14 @@ getValFromObject(const apl::Radii& radii, WASMMetrics* metrics);
 emscripten::val
 getValFromObject(const apl::Rect& rect, WASMMetrics* metrics);
 
+/**
+ * Formats an apl::Transform2D as a CSS matrix() string.
+ * @param transform The Transform2D to format
+ * @return The CSS transform string
+ */
+std::string
+getTransformString(const apl::Transform2D& transform);
+
 apl::Object
 getObjectFromVal(emscripten::val val);
 
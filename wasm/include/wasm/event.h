@@ -7,6 +7,7 @@
 #define APL_WASM_EVENT_H
 
 #include "apl/apl.h"
+#include "wasm/componentregistry.h"
 #include <emscripten/bind.h>
 
 namespace apl {
@@ -18,6 +19,7 @@ struct EventMethods {
     static int getType(apl::Event& event);
     static emscripten::val getValue(const apl::Event& event, int key);
     static apl::ComponentPtr getComponent(const apl::Event& event);
+    static int getComponentHandle(const apl::Event& event);
     static void resolve(const apl::Event& event);
     static void resolveWithArg(const apl::Event& event, int argument);
     static void resolveWithRect(const apl::Event& event, int x, int y, int width, int height);
@@ -25,6 +27,16 @@ struct EventMethods {
     static bool isPending(const apl::Event& event);
     static bool isTerminated(const apl::Event& event);
     static bool isResolved(const apl::Event& event);
+
+    /**
+     * Convert an event for the viewhost in one go.
+     * @param event The event
+     * @param token The resolve token of the event
+     * @param components Registry resolving the handle of the event component
+     * @return Object holding the "type", the "token", the "componentHandle" and the "values" of
+     *         every populated EventProperty, keyed by property
+     */
+    static emscripten::val decode(const apl::Event& event, int token, ComponentRegistry& components);
 };
 } // namespace internal
 
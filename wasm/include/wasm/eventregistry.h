@@ -0,0 +1,53 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_EVENTREGISTRY_H
+#define APL_WASM_EVENTREGISTRY_H
+
+#include "apl/apl.h"
+#include <map>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Resolve tokens for the drained events of one root context. Only events that wait on the
+ * viewhost get a token; the registry keeps them until they are resolved or terminated, so the
+ * viewhost can hold a plain integer instead of an embind event wrapper.
+ */
+class EventRegistry {
+public:
+    static const int INVALID_TOKEN = 0;
+
+    /**
+     * @param event The event
+     * @return A new token for the event, or INVALID_TOKEN if nothing waits on the event
+     */
+    int retain(const Event& event);
+
+    /**
+     * @param token The token
+     * @return The event, or nullptr if the token is unknown or has been released
+     */
+    const Event* get(int token) const;
+
+    void release(int token);
+
+    /**
+     * Release the events that have been resolved or terminated.
+     */
+    void prune();
+
+    size_t size() const { return mEvents.size(); }
+
+private:
+    int mNextToken = INVALID_TOKEN + 1;
+    std::map<int, Event> mEvents;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_EVENTREGISTRY_H
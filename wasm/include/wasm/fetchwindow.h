@@ -0,0 +1,109 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_FETCHWINDOW_H
+#define APL_WASM_FETCHWINDOW_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+#include <map>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Sizes the dynamicIndexList fetch requests of a root context from the way its lists scroll.
+ *
+ * Core asks for a fixed chunk of items at a time, so a fling through a long list waits on one
+ * small request after the other. The window follows the scroll velocity reported through
+ * updateScrollPosition, in items per second from the displayed children of the scrolled
+ * component, and widens requests to cover LOOKAHEAD of scrolling in the direction of the scroll,
+ * up to the max window. An idle list gets the chunk core asked for.
+ *
+ * Requests in flight are remembered per list until their update arrives or they time out. The
+ * widening stops short of the ranges in flight and of the minimumInclusiveIndex and
+ * maximumExclusiveIndex of the list. A request already covered by one in flight is sent as core
+ * asked for it, so its correlation token is still answered.
+ *
+ * The bounds of a list come from its data source, as recorded with the content, and follow the
+ * updates of the list.
+ */
+class FetchWindow {
+public:
+    // Seconds of scrolling a widened request covers
+    static constexpr double LOOKAHEAD = 1.0;
+    // Milliseconds without a scroll update after which a list is idle
+    static constexpr double IDLE_TIME = 300;
+    // Milliseconds after which a request in flight is forgotten
+    static constexpr double REQUEST_TIMEOUT = 5000;
+
+    /**
+     * Take over the bounds of the dynamicIndexList data sources of a content.
+     * @param content The content the context is inflated from
+     */
+    void adoptBounds(const ContentPtr& content);
+
+    /**
+     * @param maxWindow Largest number of items of a request, 0 to leave requests alone
+     */
+    void setMaxWindow(int maxWindow) { mMaxWindow = maxWindow; }
+    bool isEnabled() const { return mMaxWindow > 0; }
+
+    /**
+     * Record a scroll position of a component.
+     * @param component The scrolled component
+     * @param position The scroll position, in core units
+     */
+    void observeScroll(const ComponentPtr& component, float position);
+
+    /**
+     * @param payload The {listId, correlationToken, startIndex, count} payload of a fetch request
+     * @return The payload to send
+     */
+    emscripten::val adjust(emscripten::val payload);
+
+    /**
+     * Forget the request in flight answered by an update, and follow the bounds of its list.
+     * @param payload The update payload
+     */
+    void complete(const std::string& payload);
+
+    /**
+     * @param count Number of items asked for by core
+     * @return Number of items to ask for
+     */
+    int getWindow(int count) const;
+
+private:
+    struct Bounds {
+        int minimum;    // Inclusive
+        int maximum;    // Exclusive
+    };
+
+    struct Request {
+        std::string correlationToken;
+        int start;
+        int end;
+        double time;
+    };
+
+    void expire(double now);
+    bool adoptList(const rapidjson::Value& value);
+    void updateBounds(const std::string& listId, const rapidjson::Value& update);
+
+    int mMaxWindow = 0;
+    const Component* mScroller = nullptr;
+    float mLastPosition = 0;
+    double mLastTime = 0;
+    double mVelocity = 0;       // Items per second, negative when scrolling backwards
+    std::map<std::string, std::vector<Request>> mInFlight;
+    std::map<std::string, Bounds> mBounds;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_FETCHWINDOW_H
@@ -0,0 +1,120 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_FONTMETRICS_H
+#define APL_WASM_FONTMETRICS_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+class FontMetrics;
+using FontMetricsPtr = std::shared_ptr<FontMetrics>;
+
+/**
+ * Glyph metrics read from a TrueType or CFF flavoured OpenType font file: the character map,
+ * horizontal advances, line metrics and pair kerning from the legacy kern table or the GPOS
+ * 'kern' feature. All values are in font units; scale by fontSize / unitsPerEm().
+ */
+class FontMetrics {
+public:
+    /**
+     * Parse a font file.
+     * @param data Raw font file bytes. Ownership is taken, GPOS kerning is read on demand.
+     * @return The font metrics, or nullptr if the file is not a supported font.
+     */
+    static FontMetricsPtr create(std::vector<uint8_t>&& data);
+
+    uint16_t unitsPerEm() const { return mUnitsPerEm; }
+    int16_t ascender() const { return mAscender; }
+    int16_t descender() const { return mDescender; }
+    int16_t lineGap() const { return mLineGap; }
+
+    /**
+     * @return Glyph index for a unicode code point, 0 (.notdef) when the font has no glyph.
+     */
+    uint16_t glyph(uint32_t codepoint) const;
+
+    /**
+     * @return Advance width of the glyph.
+     */
+    uint16_t advance(uint16_t glyph) const;
+
+    /**
+     * @return Horizontal kerning adjustment between two glyphs.
+     */
+    int16_t kerning(uint16_t left, uint16_t right) const;
+
+private:
+    /**
+     * Consecutive code points mapped to consecutive glyphs: start maps to glyph, end to
+     * glyph + (end - start). Kept as ranges so large format 12 groups cost one entry.
+     */
+    struct GlyphRange {
+        uint32_t start;
+        uint32_t end;
+        uint32_t glyph;
+
+        bool operator<(const GlyphRange& other) const { return start < other.start; }
+    };
+
+    bool parse();
+    bool parseCmap(uint32_t offset);
+    void parseKern(uint32_t offset);
+    void parseGpos(uint32_t offset);
+    int16_t gposKerning(uint16_t left, uint16_t right) const;
+    int coverageIndex(uint32_t offset, uint16_t glyph) const;
+    uint16_t glyphClass(uint32_t offset, uint16_t glyph) const;
+
+    uint16_t u16(uint32_t offset) const;
+    int16_t s16(uint32_t offset) const { return static_cast<int16_t>(u16(offset)); }
+    uint32_t u32(uint32_t offset) const;
+
+    std::vector<uint8_t> mData;
+    uint16_t mUnitsPerEm = 1000;
+    int16_t mAscender = 0;
+    int16_t mDescender = 0;
+    int16_t mLineGap = 0;
+    std::vector<uint16_t> mAdvances;
+    uint16_t mAsciiGlyphs[128] = {};
+    std::vector<GlyphRange> mGlyphs;
+    std::unordered_map<uint32_t, int16_t> mKerning;
+    std::vector<uint32_t> mPairPositioning;
+    mutable std::unordered_map<uint32_t, int16_t> mGposKerning;
+};
+
+/**
+ * Fonts available to native text measurement, shared by every document in the module.
+ */
+class FontRegistry {
+public:
+    /**
+     * Register a font file for a family, weight and style.
+     * @param family Font family as referenced by fontFamily in APL documents
+     * @param weight Font weight, 100 to 900
+     * @param italic True for an italic face
+     * @param data ArrayBuffer or typed array holding the font file
+     * @return True if the font was parsed and registered
+     */
+    static bool registerFont(const std::string& family, int weight, bool italic, emscripten::val data);
+
+    /**
+     * Find the closest registered face. Families are tried in order, then any registered family.
+     * @return The font, or nullptr if no font is registered.
+     */
+    static FontMetricsPtr find(const std::vector<std::string>& families, int weight, bool italic);
+
+    static bool hasFonts();
+
+    static void clear();
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_FONTMETRICS_H
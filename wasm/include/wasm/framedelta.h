@@ -0,0 +1,71 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_FRAMEDELTA_H
+#define APL_WASM_FRAMEDELTA_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+
+namespace apl {
+namespace wasm {
+
+class WASMMetrics;
+
+/**
+ * Packs the dirty properties of every dirty component into one reusable buffer, so the viewhost
+ * can apply a whole frame of changes without a getDirtyProps() call per component.
+ *
+ * The buffer is a flat array of doubles:
+ *   [0]       component count N
+ *   [1]       record count R
+ *   N entries (uniqueId offset, uniqueId length) into the string table
+ *   R entries (component index, property key, value kind, payload 0..3)
+ *
+ * Strings are UTF-8 encoded into the string table and referenced as (offset, length). Values
+ * without a packed form are converted with getValFromObject and referenced by their index in
+ * the objects array. The buffer and string table are owned by this object and stay valid only
+ * until the next call to collect().
+ */
+class FrameDelta {
+public:
+    enum ValueKind {
+        kValueKindUndefined = 0,
+        kValueKindNumber = 1,
+        kValueKindBoolean = 2,
+        kValueKindColor = 3,
+        kValueKindString = 4,
+        kValueKindRect = 5,
+        kValueKindRadii = 6,
+        kValueKindObject = 7
+    };
+
+    static const size_t HEADER_SIZE = 2;
+    static const size_t COMPONENT_SIZE = 2;
+    static const size_t RECORD_SIZE = 7;
+
+    /**
+     * Pack the dirty properties of the dirty components.
+     * @param dirty The dirty components reported by the root context
+     * @param metrics Metrics for transforming dimensions to and from core to viewhost
+     * @return Object holding the "buffer" and "strings" heap views and the "objects" array
+     */
+    emscripten::val collect(const std::set<ComponentPtr>& dirty, WASMMetrics* metrics);
+
+private:
+    void addRecord(size_t componentIndex, PropertyKey key, const Object& value,
+                   WASMMetrics* metrics, emscripten::val& objects);
+    void addPayload(ValueKind kind, double p0 = 0, double p1 = 0, double p2 = 0, double p3 = 0);
+    size_t addString(const std::string& value);
+
+    std::vector<double> mBuffer;
+    std::string mStrings;
+    size_t mObjectCount = 0;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_FRAMEDELTA_H
@@ -0,0 +1,46 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_JSONBRIDGE_H
+#define APL_WASM_JSONBRIDGE_H
+
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Hands serialized core state, such as the visual context, to the viewhost without going through
+ * a std::string.
+ *
+ * kModeView writes the JSON into one growable buffer shared by the module and returns a Uint8Array
+ * view of it, which the viewhost decodes with a TextDecoder. The view is only valid until the next
+ * call into the module, so it must be decoded right away. kModeObject builds the JS object in a
+ * single walk of the value, so the viewhost does not parse the JSON at all.
+ */
+class JsonBridge {
+public:
+    enum Mode {
+        kModeString = 0,
+        kModeView = 1,
+        kModeObject = 2
+    };
+
+    /**
+     * @param value The value to hand over
+     * @param mode A Mode
+     * @return A JS string, a Uint8Array view of UTF-8 JSON or a JS object, depending on mode
+     */
+    static emscripten::val convert(const rapidjson::Value& value, int mode);
+
+    static emscripten::val toView(const rapidjson::Value& value);
+    static emscripten::val toObject(const rapidjson::Value& value);
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_JSONBRIDGE_H
@@ -0,0 +1,77 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_JSONBUFFER_H
+#define APL_WASM_JSONBUFFER_H
+
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+#include <memory>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * UTF-8 JSON written straight into the wasm heap, so large documents and data sources skip the
+ * JS string and the copy embind makes of it.
+ *
+ * The viewhost allocates a buffer, fills it from the network bytes (or lets fromArray copy a
+ * Uint8Array) and hands the address to one of the *FromBuffer methods, which take the buffer over
+ * and parse it in situ. A buffer that is never parsed must be freed.
+ *
+ * Buffers may also hold gzip or zlib compressed JSON, which is inflated in wasm as it is parsed.
+ * Brotli is not supported, there is no brotli port in the toolchain.
+ */
+class JsonBuffer {
+public:
+    /**
+     * @param length Number of bytes of JSON
+     * @return Address of a buffer of length bytes, 0 if it could not be allocated
+     */
+    static uintptr_t allocate(size_t length);
+
+    /**
+     * @param array Uint8Array holding UTF-8 JSON
+     * @return Address of a buffer holding a copy of the array
+     */
+    static uintptr_t fromArray(emscripten::val array);
+
+    /**
+     * Release a buffer that has not been parsed.
+     */
+    static void free(uintptr_t address);
+
+    /**
+     * Take a buffer over without parsing it.
+     * @param address Address returned by allocate or fromArray
+     * @param length Number of bytes used, clamped to the allocated length
+     * @return The buffer, or nullptr for an unknown buffer
+     */
+    static std::unique_ptr<char[]> release(uintptr_t address, size_t& length);
+
+    /**
+     * Parse a buffer in situ. The buffer is taken over by the document whether or not it parses.
+     * @param address Address returned by allocate or fromArray
+     * @param length Number of bytes of JSON, at most the allocated length
+     * @return The document, which may hold a parse error, or nullptr for an unknown buffer
+     */
+    static std::shared_ptr<rapidjson::Document> parse(uintptr_t address, size_t length);
+
+    /**
+     * Parse a buffer holding gzip or zlib compressed JSON. The JSON is inflated a chunk at a time
+     * into the reader, so the decompressed text is never held in full. The buffer is released
+     * once parsed.
+     * @param address Address returned by allocate or fromArray
+     * @param length Number of compressed bytes, at most the allocated length
+     * @return The document, which may hold a parse error, or nullptr for an unknown buffer or
+     *         compressed data that does not inflate
+     */
+    static std::shared_ptr<rapidjson::Document> parseCompressed(uintptr_t address, size_t length);
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_JSONBUFFER_H
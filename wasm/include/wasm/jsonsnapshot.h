@@ -0,0 +1,68 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_JSONSNAPSHOT_H
+#define APL_WASM_JSONSNAPSHOT_H
+
+#include <rapidjson/document.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Binary image of a parsed JSON document, such as a package, produced offline by the apl-snapshot
+ * tool and loaded without parsing any text.
+ *
+ * The image is a header followed by a tape of tagged values in document order:
+ *
+ *   magic "APLJ" | format version (u16) | reserved (u16) | body size (u32) | body hash (u64)
+ *   | reference size (u32) | reference | body
+ *
+ * The reference is the "name:version" of the package, empty if unknown. Numbers are little
+ * endian. Strings are stored with their length and a terminating NUL, so the loaded document
+ * points into the image instead of copying them. Images of another format version, with a body
+ * that does not match its hash, or made for another reference are rejected.
+ */
+class JsonSnapshot {
+public:
+    static const uint16_t FORMAT_VERSION = 1;
+
+    /**
+     * A document loaded from an image. The strings of the document live in the image, so both
+     * are kept together.
+     */
+    struct Image {
+        std::vector<uint8_t> data;
+        rapidjson::Document document;
+    };
+
+    /**
+     * @param value The value to store
+     * @param reference The package reference, or empty
+     * @return The image
+     */
+    static std::vector<uint8_t> encode(const rapidjson::Value& value, const std::string& reference);
+
+    /**
+     * @param data The image, taken over by the result
+     * @param reference The expected package reference, or empty to accept any
+     * @return The document of the image, or nullptr if the image is rejected
+     */
+    static std::shared_ptr<rapidjson::Document> decode(std::vector<uint8_t>&& data, const std::string& reference);
+
+    /**
+     * 64 bit FNV-1a hash.
+     */
+    static uint64_t hash(const uint8_t* data, size_t size);
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_JSONSNAPSHOT_H
@@ -0,0 +1,65 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_KEYTABLE_H
+#define APL_WASM_KEYTABLE_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Interned KeyboardEvent.code and KeyboardEvent.key strings, so key events cross into wasm as
+ * integers. The table starts with the DOM code values and the named key values, and grows as the
+ * viewhost interns anything else, up to MAX_STRINGS. Ids never change once assigned; id 0 is the
+ * empty string.
+ */
+class KeyTable {
+public:
+    enum Modifier {
+        kModifierRepeat = 1 << 0,
+        kModifierAlt = 1 << 1,
+        kModifierCtrl = 1 << 2,
+        kModifierMeta = 1 << 3,
+        kModifierShift = 1 << 4
+    };
+
+    /**
+     * Upper bound of the table. Key values are free text on some keyboards, so past this the
+     * viewhost sends key events as strings instead of growing the table for the page lifetime.
+     */
+    static const size_t MAX_STRINGS = 1024;
+
+    /**
+     * @param value A code or key string
+     * @return The id of the string, interning it if needed, or -1 if the table is full
+     */
+    static int intern(const std::string& value);
+
+    /**
+     * @return The string of an id, the empty string for an unknown id
+     */
+    static const std::string& get(int id);
+
+    /**
+     * @return Array of every interned string, indexed by id, to seed the viewhost side lookup
+     */
+    static emscripten::val getStrings();
+
+    /**
+     * Build the core keyboard event of interned ids.
+     * @param codeId Id of KeyboardEvent.code
+     * @param keyId Id of KeyboardEvent.key
+     * @param modifiers Bitmask of Modifier values
+     */
+    static Keyboard keyboard(int codeId, int keyId, int modifiers);
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_KEYTABLE_H
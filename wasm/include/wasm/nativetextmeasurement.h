@@ -0,0 +1,46 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_NATIVETEXTMEASUREMENT_H
+#define APL_WASM_NATIVETEXTMEASUREMENT_H
+
+#include "apl/apl.h"
+#include "wasm/fontmetrics.h"
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Text measurement computed in wasm from the font files registered with FontRegistry, without
+ * calling back into the viewhost or touching the DOM. Lines break greedily at spaces and newlines,
+ * falling back to breaking inside a word that does not fit, and truncated text ends with an
+ * ellipsis replacing the last word, like the DOM measurement.
+ *
+ * Styled text spans are measured with the component font; font changes inside spans are not
+ * taken into account.
+ */
+class NativeTextMeasurement : public apl::sg::TextMeasurement {
+public:
+    apl::sg::TextLayoutPtr layout(apl::Component *textComponent,
+                                  const apl::sg::TextChunkPtr& chunk,
+                                  const apl::sg::TextPropertiesPtr& textProperties,
+                                  float width,
+                                  apl::MeasureMode widthMode,
+                                  float height,
+                                  apl::MeasureMode heightMode) override;
+
+    apl::sg::EditTextBoxPtr box(apl::Component *textComponent,
+                                int size,
+                                const apl::sg::TextPropertiesPtr& textProperties,
+                                float width,
+                                apl::MeasureMode widthMode,
+                                float height,
+                                apl::MeasureMode heightMode) override;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_NATIVETEXTMEASUREMENT_H
@@ -0,0 +1,149 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_PACKAGECACHE_H
+#define APL_WASM_PACKAGECACHE_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+
+namespace apl {
+namespace wasm {
+
+class PackageManager;
+
+/**
+ * An entry of the "import" list of a document or package.
+ */
+struct PackageImport {
+    std::string name;
+    std::string version;
+    std::string source;
+    std::string domain;
+};
+
+/**
+ * Imported packages shared by every document of the module.
+ *
+ * Parsed packages are kept by key in an LRU bounded by the size of their JSON, so the common packages of a skill, such as alexa-layouts and alexa-styles, are fetched
+ * and parsed once and then imported by later documents without a round trip to the viewhost.
+ *
+ * A package is fetched once at a time: requests that arrive while it is in flight wait for the
+ * same fetch, whichever package manager asked for it.
+ *
+ * The cache also remembers the imports of every package it parses, and accepts import graphs
+ * known ahead of time, so the nested imports of a document can be fetched in parallel up front
+ * instead of one layer per round trip.
+ */
+class PackageCache {
+public:
+    static const size_t DEFAULT_BYTE_BUDGET = 4 * 1024 * 1024;
+    static const size_t MAX_GRAPH_ENTRIES = 256;
+
+    /**
+     * The key of a package in the cache and the import graph. Every lookup goes through one of
+     * these, so requests, prefetched imports and graph entries always agree.
+     *
+     * The key is the "name:version" reference of the package, followed by "|domain|source" when
+     * either is set: packages of the same name and version from different sources or domains are
+     * different packages.
+     * @return The key of the package requested by core
+     */
+    static std::string key(const ImportRequest& request);
+
+    /**
+     * @return The key of a package listed in an import graph
+     */
+    static std::string key(const PackageImport& packageImport);
+
+    /**
+     * @param key The package key
+     * @return The "name:version" reference of the package
+     */
+    static std::string reference(const std::string& key);
+
+    /**
+     * @param key The package key
+     * @return True if the package is cached. Unlike get, not counted as a hit or a miss.
+     */
+    static bool contains(const std::string& key);
+
+    /**
+     * @param reference The package reference
+     * @return The parsed package, or nullptr if it is not cached
+     */
+    static std::shared_ptr<rapidjson::Document> get(const std::string& reference);
+
+    /**
+     * Queue a request behind the fetch of its package.
+     * @param reference The package reference
+     * @param manager The package manager of the request
+     * @param request The request
+     * @return True if the request is the first one, and the package has to be fetched
+     */
+    static bool wait(const std::string& reference, PackageManager* manager, const PackageRequestPtr& request);
+
+    /**
+     * Complete the fetch of a package: parse and cache it, then resolve every waiting request.
+     * Also used to add prefetched packages.
+     * @return False if no request was waiting on the package
+     */
+    static bool succeed(const std::string& reference, const std::string& packageJson);
+
+    /**
+     * Complete the fetch of a package from a binary snapshot, see JsonSnapshot.
+     * @param snapshot Uint8Array holding the snapshot
+     * @return False if the snapshot is rejected, in which case waiting requests keep waiting
+     */
+    static bool succeedWithSnapshot(const std::string& reference, emscripten::val snapshot);
+
+    /**
+     * Fail every request waiting on a package.
+     * @return False if no request was waiting on the package
+     */
+    static bool fail(const std::string& reference, const std::string& msg, int code);
+
+    /**
+     * Drop the requests of a package manager that is going away. Fetches it started are handed
+     * over to the next manager waiting on the same package.
+     */
+    static void release(PackageManager* manager);
+
+    /**
+     * @param roots Keys of the imports of a document
+     * @return Every package reachable from the roots through the known import graph, excluding the
+     *         roots and the packages that are cached or in flight
+     */
+    static std::vector<PackageImport> transitiveImports(const std::vector<std::string>& roots);
+
+    /**
+     * Add known dependencies, such as a manifest or a graph persisted by an earlier session.
+     * @param graph Object mapping a package key to its imports, {name, version, source?, domain?} each
+     */
+    static void addImportGraph(emscripten::val graph);
+
+    /**
+     * @return The known import graph, in the format of addImportGraph
+     */
+    static emscripten::val getImportGraph();
+
+    /**
+     * Drop the cached packages. Fetches in flight and the import graph are kept.
+     */
+    static void clear();
+
+    static void setByteBudget(size_t byteBudget);
+
+    /**
+     * @return Object holding the "hits", "misses", "entries", "bytes", "byteBudget" and "inFlight" counts
+     */
+    static emscripten::val getStats();
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_PACKAGECACHE_H
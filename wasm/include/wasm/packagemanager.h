@@ -20,19 +20,23 @@ using PackageManagerPtr = std::shared_ptr<PackageManager>;
 class PackageManager : public apl::PackageManager {
 public:
     PackageManager(emscripten::val importPackageCallback);
+    ~PackageManager();
     static PackageManagerPtr create(emscripten::val importPackageCallback);
     void destroy();
 
     // Core is requesting a package be dynamically downloaded and imported.
+    // Cached packages are imported right away, and a package already being fetched is not fetched again.
     void loadPackage(const PackageRequestPtr& packageRequest) override;
 
     // Callback used by JS side to response to a request
-    void importPackageSucceeded(const std::string& reference, const std::string& packageJson);
-    void importPackageFailed(const std::string& reference, const std::string& msg, int code);
+    void importPackageSucceeded(const ImportRequest& request, const std::string& packageJson);
+    void importPackageFailed(const ImportRequest& request, const std::string& msg, int code);
+
+    // Ask the JS side to download a package
+    void fetch(const PackageRequestPtr& packageRequest);
 
 private:
     emscripten::val mImportPackageCallback; 
-    std::map<std::string, PackageRequestPtr> mPendingPackageRequests;
 };
 } // namespace wasm
 } // namespace apl
@@ -0,0 +1,80 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_PROPERTYCONVERSION_H
+#define APL_WASM_PROPERTYCONVERSION_H
+
+#include "apl/apl.h"
+#include <vector>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * The way an apl::Object is converted to a JavaScript value. The order matches the precedence
+ * of the type tests in classify(), so a value always resolves to the same kind.
+ */
+enum ConversionKind : uint8_t {
+    kConversionUnknown = 0,
+    kConversionNumber,
+    kConversionBoolean,
+    kConversionString,
+    kConversionColor,
+    kConversionAbsoluteDimension,
+    kConversionFilter,
+    kConversionRadii,
+    kConversionRect,
+    kConversionGradient,
+    kConversionGraphicFilter,
+    kConversionGraphicPattern,
+    kConversionMediaSource,
+    kConversionMap,
+    kConversionArray,
+    kConversionStyledText,
+    kConversionGraphic,
+    kConversionTransform2D,
+    kConversionURLRequest,
+    kConversionUndefined
+};
+
+/**
+ * Table of the conversion kind of each PropertyKey.
+ *
+ * The table starts from the kinds of the well-known component properties and learns the others
+ * from the first value it sees. A lookup checks the expected kind with a single type test and
+ * only falls back to the full classification when the value does not match, which happens for
+ * properties that legitimately change type, such as a background that is either a color or a
+ * gradient.
+ */
+class PropertyConversion {
+public:
+    /**
+     * Run the full chain of type tests.
+     * @param value The value to classify
+     * @return The conversion kind of the value, kConversionUndefined if it has no JavaScript form
+     */
+    static ConversionKind classify(const Object& value);
+
+    /**
+     * @return True if the value converts with the given kind
+     */
+    static bool matches(const Object& value, ConversionKind kind);
+
+    /**
+     * Resolve the conversion kind of a property value, using and updating the table.
+     * @param key The property key
+     * @param value The calculated value of the property
+     * @return The conversion kind of the value
+     */
+    static ConversionKind lookup(PropertyKey key, const Object& value);
+
+private:
+    static std::vector<ConversionKind>& table();
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_PROPERTYCONVERSION_H
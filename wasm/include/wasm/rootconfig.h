@@ -36,6 +36,23 @@ struct RootConfigMethods {
     
     static RootConfigPtr& packageManager(RootConfigPtr& rootConfig, emscripten::val packageManager);
     static RootConfigPtr& documentManager(RootConfigPtr& rootConfig, emscripten::val documentManager);
+
+    static RootConfigPtr& textMeasurementMode(RootConfigPtr& rootConfig, const std::string& mode);
+
+    /**
+     * Configure the dynamicIndexList provider that Context.create registers for each context,
+     * instead of the default one.
+     * @param configuration Object with optional cacheChunkSize, listUpdateBufferSize, fetchRetries,
+     *        fetchTimeout and cacheExpiryTimeout values
+     */
+    static RootConfigPtr& dynamicIndexListConfiguration(RootConfigPtr& rootConfig, emscripten::val configuration);
+
+    /**
+     * A provider holds the lists of the documents it serves, so every context gets its own.
+     * @return A new dynamicIndexList provider built from the configuration given to
+     *         dynamicIndexListConfiguration, or nullptr if there was none.
+     */
+    static DataSourceProviderPtr createDynamicIndexListProvider(const RootConfigPtr& rootConfig);
 };
 } // namespace internal
 
@@ -0,0 +1,126 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_TEXTLAYOUTCACHE_H
+#define APL_WASM_TEXTLAYOUTCACHE_H
+
+#include "apl/apl.h"
+#include <list>
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+/**
+ * Least recently used cache of measured text layouts and edit text boxes.
+ *
+ * Entries are keyed by the measured text (or edit box size), the text properties hash and the
+ * measure constraints, so re-measuring unchanged text does not call back into the viewhost.
+ * The cache is bounded by an estimated byte budget; a budget of zero disables caching.
+ */
+class TextLayoutCache {
+public:
+    static const size_t DEFAULT_BYTE_BUDGET = 1024 * 1024;
+
+    explicit TextLayoutCache(size_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    apl::sg::TextLayoutPtr findLayout(const std::string& text,
+                                      const apl::sg::TextPropertiesPtr& textProperties,
+                                      float width,
+                                      apl::MeasureMode widthMode,
+                                      float height,
+                                      apl::MeasureMode heightMode);
+
+    void putLayout(const std::string& text,
+                   const apl::sg::TextPropertiesPtr& textProperties,
+                   float width,
+                   apl::MeasureMode widthMode,
+                   float height,
+                   apl::MeasureMode heightMode,
+                   const apl::sg::TextLayoutPtr& layout,
+                   size_t layoutBytes);
+
+    apl::sg::EditTextBoxPtr findBox(int size,
+                                    const apl::sg::TextPropertiesPtr& textProperties,
+                                    float width,
+                                    apl::MeasureMode widthMode,
+                                    float height,
+                                    apl::MeasureMode heightMode);
+
+    void putBox(int size,
+                const apl::sg::TextPropertiesPtr& textProperties,
+                float width,
+                apl::MeasureMode widthMode,
+                float height,
+                apl::MeasureMode heightMode,
+                const apl::sg::EditTextBoxPtr& box);
+
+    /**
+     * Drop every cached entry. Called when anything outside the key affects measurement, such
+     * as a font scale, metrics or other configuration change.
+     */
+    void clear();
+
+    /**
+     * Change the byte budget, evicting the least recently used entries until it fits.
+     */
+    void setByteBudget(size_t byteBudget);
+
+    size_t getByteBudget() const { return mByteBudget; }
+    size_t getBytes() const { return mBytes; }
+    size_t getEntryCount() const { return mEntries.size(); }
+    size_t getHits() const { return mHits; }
+    size_t getMisses() const { return mMisses; }
+    size_t getEvictions() const { return mEvictions; }
+
+private:
+    struct Key {
+        bool isBox;
+        std::string text;
+        int size;
+        size_t propertiesHash;
+        float width;
+        int widthMode;
+        float height;
+        int heightMode;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        apl::sg::TextLayoutPtr layout;
+        apl::sg::EditTextBoxPtr box;
+        size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static Key makeKey(bool isBox, const std::string& text, int size,
+                       const apl::sg::TextPropertiesPtr& textProperties,
+                       float width, apl::MeasureMode widthMode,
+                       float height, apl::MeasureMode heightMode);
+
+    const Entry* find(const Key& key);
+    void put(Entry&& entry);
+    void evict();
+
+    size_t mByteBudget;
+    size_t mBytes = 0;
+    size_t mHits = 0;
+    size_t mMisses = 0;
+    size_t mEvictions = 0;
+    EntryList mEntries;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> mIndex;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_TEXTLAYOUTCACHE_H
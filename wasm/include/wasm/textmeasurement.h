@@ -7,17 +7,21 @@
 #define APL_WASM_TEXTMEASUREMENT_H
 
 #include "apl/apl.h"
+#include "wasm/textlayoutcache.h"
 #include <emscripten/bind.h>
 
 namespace apl {
 namespace wasm {
 
 class WASMMetrics;
+class WasmTextLayout;
+class WasmEditTextBox;
 
 class WasmTextMeasurement : public apl::sg::TextMeasurement {
 public:
     WasmTextMeasurement(emscripten::val measureCallback,
-                        WASMMetrics *wasmMetrics);
+                        WASMMetrics *wasmMetrics,
+                        emscripten::val measureBatchCallback = emscripten::val::undefined());
 
     apl::sg::TextLayoutPtr layout(apl::Component *textComponent,
                                   const apl::sg::TextChunkPtr& chunk,
@@ -35,9 +39,52 @@ public:
                                 float height,
                                 apl::MeasureMode heightMode) override;
 
+    /**
+     * Replace the metrics used to convert measurements. Cached layouts were measured with the
+     * previous metrics, so the layout cache is cleared.
+     */
+    void setMetrics(WASMMetrics *wasmMetrics);
+
+    TextLayoutCache& getCache() { return mCache; }
+
+    /**
+     * @return True if a batch measure callback was provided.
+     */
+    bool canBatch() const { return !mMeasureBatchCallback.isUndefined(); }
+
+    /**
+     * Start collecting measurements. While collecting, every cache miss is recorded and answered
+     * with a provisional single line estimate, so the layout pass that follows must be repeated
+     * once the batch is resolved.
+     */
+    void beginBatch();
+
+    /**
+     * Measure every collected request with a single call to the batch measure callback and store
+     * the results in the layout cache. Ends collection.
+     * @return Number of requests measured.
+     */
+    size_t resolveBatch();
+
 private:
+    struct PendingMeasure {
+        apl::ComponentPtr component;
+        std::string text;
+        int size;
+        apl::sg::TextPropertiesPtr textProperties;
+        float width;
+        apl::MeasureMode widthMode;
+        float height;
+        apl::MeasureMode heightMode;
+        bool isBox;
+    };
+
     emscripten::val mMeasureCallback;
+    emscripten::val mMeasureBatchCallback;
     WASMMetrics *mWasmMetrics;
+    TextLayoutCache mCache;
+    bool mBatching = false;
+    std::vector<PendingMeasure> mPending;
 
     emscripten::val measureLayout(apl::Component *component,
                                   float width,
@@ -45,6 +92,16 @@ private:
                                   float height,
                                   apl::MeasureMode heightMode);
 
+    std::shared_ptr<WasmTextLayout> createLayout(const emscripten::val& layout, size_t& layoutBytes);
+
+    std::shared_ptr<WasmEditTextBox> createBox(const emscripten::val& layout);
+
+    apl::Size estimateSize(const apl::sg::TextPropertiesPtr& textProperties,
+                           float width,
+                           apl::MeasureMode widthMode,
+                           float height,
+                           apl::MeasureMode heightMode);
+
     std::vector<std::string> convertToStringVector(const emscripten::val& textsByLine);
 
     std::vector<apl::Rect> convertToRectVector(const emscripten::val& rectsByLine);
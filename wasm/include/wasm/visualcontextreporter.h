@@ -0,0 +1,98 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef APL_WASM_VISUALCONTEXTREPORTER_H
+#define APL_WASM_VISUALCONTEXTREPORTER_H
+
+#include "apl/apl.h"
+#include <emscripten/bind.h>
+#include <rapidjson/document.h>
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+class VisualContextReporter;
+using VisualContextReporterPtr = std::shared_ptr<VisualContextReporter>;
+
+/**
+ * Reports the visual context of a document as changes against the last report.
+ *
+ * The reporter keeps the last reported tree flattened by node uid. Each report is one of:
+ *   {"type": "full", "version": n, "context": {...}}
+ *   {"type": "delta", "version": n, "base": n - 1, "added": [...], "removed": [...], "changed": [...]}
+ *   {"type": "unchanged", "version": n - 1}
+ * Added and changed entries are {"uid", "parent", "index", "node"}, where node is the visual
+ * context entry without its children. Removed entries are uids. Nodes without a uid are keyed by
+ * the uid of their parent and their index.
+ *
+ * A document that has not changed since the last report is not serialized at all. Core has a
+ * single visual context dirty flag per document, so changes are counted in a generation of the
+ * document instead: the reporter and the DocumentContext isVisualContextDirty binding each
+ * compare it with the generation they last saw, and neither hides a change from the other.
+ *
+ * After fullEvery deltas the next report is a full one, so a consumer that lost a delta catches
+ * up; 0 only sends the first report in full.
+ */
+class VisualContextReporter {
+public:
+    static VisualContextReporterPtr create(int fullEvery);
+
+    explicit VisualContextReporter(int fullEvery) : mFullEvery(fullEvery) {}
+
+    /**
+     * @param context The document context
+     * @param mode A JsonBridge::Mode
+     * @return The report, in the representation of mode
+     */
+    emscripten::val report(const DocumentContextPtr& context, int mode);
+
+    /**
+     * Send the next report in full.
+     */
+    void reset();
+
+    int getVersion() const { return mVersion; }
+
+    /**
+     * @return The visual context generation of a document, bumped by every change core flagged
+     */
+    static unsigned generation(const DocumentContextPtr& context);
+
+    /**
+     * @return True if the visual context changed since the viewhost last cleared it
+     */
+    static bool isDirty(const DocumentContextPtr& context);
+
+    /**
+     * Mark the current visual context of a document as seen by the viewhost.
+     */
+    static void clearDirty(const DocumentContextPtr& context);
+
+private:
+    struct Entry {
+        std::string parent;
+        int index;
+        rapidjson::Value node;
+    };
+
+    using EntryMap = std::unordered_map<std::string, Entry>;
+
+    static void flatten(const rapidjson::Value& value, const std::string& parent, int index,
+                        EntryMap& entries, rapidjson::Document::AllocatorType& allocator);
+
+    int mFullEvery;
+    int mVersion = 0;
+    int mDeltaCount = 0;
+    bool mHasBase = false;
+    unsigned mGeneration = 0;
+    std::unique_ptr<rapidjson::Document> mBaseDocument;
+    EntryMap mBase;
+};
+
+} // namespace wasm
+} // namespace apl
+
+#endif // APL_WASM_VISUALCONTEXTREPORTER_H
@@ -11,24 +11,50 @@
 namespace apl {
 namespace wasm {
 
-class WASMMetrics : public MetricsTransform {
+class WASMMetrics final : public MetricsTransform {
 public:
-    explicit WASMMetrics(Metrics& metrics) : MetricsTransform(metrics) {}
-    WASMMetrics(Metrics& metrics, ScalingOptions& options) : MetricsTransform(metrics, options) {}
+    explicit WASMMetrics(Metrics& metrics) : MetricsTransform(metrics) { computeScale(); }
+    WASMMetrics(Metrics& metrics, ScalingOptions& options) : MetricsTransform(metrics, options) { computeScale(); }
 
     /**
      * Converts dp units into px units
      * @param value dp unit
      * @return px unit
      */
-    float toViewhost(float value) const override;
+    float toViewhost(float value) const override { return value * mViewhostScale; }
 
     /**
      * Converts px units into dp units
      * @param value px unit
      * @return dp unit
      */
-    float toCore(float value) const override;
+    float toCore(float value) const override { return value * mCoreScale; }
+
+    /**
+     * Converts a rectangle from dp units into px units
+     */
+    Rect toViewhostRect(const Rect& rect) const {
+        return Rect(rect.getX() * mViewhostScale, rect.getY() * mViewhostScale,
+                    rect.getWidth() * mViewhostScale, rect.getHeight() * mViewhostScale);
+    }
+
+    /**
+     * Converts corner radii from dp units into px units
+     */
+    Radii toViewhostRadii(const Radii& radii) const {
+        return Radii(radii.topLeft() * mViewhostScale, radii.topRight() * mViewhostScale,
+                     radii.bottomLeft() * mViewhostScale, radii.bottomRight() * mViewhostScale);
+    }
+
+    /**
+     * @return Multiplier converting dp units into px units
+     */
+    float getViewhostScale() const { return mViewhostScale; }
+
+    /**
+     * @return Multiplier converting px units into dp units
+     */
+    float getCoreScale() const { return mCoreScale; }
 
     /**
      * Return the viewport width in pixels
@@ -47,6 +73,13 @@ public:
      * @return pixel height
      */
     float toCorePixel(float value);
+
+private:
+    void computeScale();
+
+    // Conversion factors, fixed for the lifetime of the transform
+    float mViewhostScale = 1.0f;
+    float mCoreScale = 1.0f;
 };
 
 } // namespace wasm
@@ -34,11 +34,6 @@ ActionMethods::addTerminateCallback(apl::ActionPtr action, emscripten::val callb
 void
 ActionMethods::then(apl::ActionPtr action, emscripten::val callback) {
     action->then([callback](const ActionPtr& action) {
-        if (action->getUserData() != nullptr) {
-            auto* doc = static_cast<rapidjson::Document*>(action->getUserData());
-            delete doc;
-            action->setUserData(nullptr);
-        }
         callback(action);
     });
 }
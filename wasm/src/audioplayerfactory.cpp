@@ -35,6 +35,15 @@ AudioPlayerFactory::tick()
     }
 }
 
+bool
+AudioPlayerFactory::isActive() const
+{
+    for (const auto& player : mPlayers) {
+        if (player->isActive()) return true;
+    }
+    return false;
+}
+
 void
 AudioPlayerFactory::destroy()
 {
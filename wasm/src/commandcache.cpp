@@ -0,0 +1,271 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/commandcache.h"
+#include "apl/utils/log.h"
+#include <rapidjson/pointer.h>
+#include <list>
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const size_t MAX_POOLED_BUFFERS = 16;
+
+std::vector<std::unique_ptr<char[]>>&
+bufferPool() {
+    static std::vector<std::unique_ptr<char[]>> pool;
+    return pool;
+}
+
+struct CacheEntry {
+    size_t hash;
+    std::string payload;
+    CommandDocumentPtr document;
+};
+
+struct CommandTemplate {
+    CommandDocumentPtr source;
+    std::vector<std::pair<rapidjson::Pointer, std::string>> slots;
+};
+
+struct CacheState {
+    std::list<CacheEntry> entries;
+    std::unordered_map<size_t, std::list<CacheEntry>::iterator> index;
+    std::unordered_map<std::string, CommandTemplate> templates;
+    size_t capacity = CommandCache::DEFAULT_CAPACITY;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+CacheState&
+cacheState() {
+    static CacheState state;
+    return state;
+}
+
+void
+trim(CacheState& state) {
+    while (state.entries.size() > state.capacity) {
+        state.index.erase(state.entries.back().hash);
+        state.entries.pop_back();
+    }
+}
+
+bool
+placeholderName(const rapidjson::Value& value, std::string& name) {
+    if (!value.IsString() || value.GetStringLength() <= 4)
+        return false;
+    std::string str(value.GetString(), value.GetStringLength());
+    if (str.compare(0, 2, "{{") != 0 || str.compare(str.size() - 2, 2, "}}") != 0)
+        return false;
+    name = str.substr(2, str.size() - 4);
+    return true;
+}
+
+void
+findSlots(const rapidjson::Value& value, const rapidjson::Pointer& path,
+          std::vector<std::pair<rapidjson::Pointer, std::string>>& slots) {
+    std::string name;
+    if (placeholderName(value, name)) {
+        slots.emplace_back(path, name);
+    } else if (value.IsArray()) {
+        for (rapidjson::SizeType i = 0; i < value.Size(); i++)
+            findSlots(value[i], path.Append(i), slots);
+    } else if (value.IsObject()) {
+        for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it)
+            findSlots(it->value, path.Append(it->name.GetString(), it->name.GetStringLength()), slots);
+    }
+}
+
+rapidjson::Value
+toJson(const emscripten::val& argument, rapidjson::Document::AllocatorType& allocator) {
+    rapidjson::Value result;
+    auto type = argument.typeOf().as<std::string>();
+    if (type == "number") {
+        result.SetDouble(argument.as<double>());
+    } else if (type == "boolean") {
+        result.SetBool(argument.as<bool>());
+    } else if (type == "string") {
+        auto str = argument.as<std::string>();
+        result.SetString(str.c_str(), str.size(), allocator);
+    } else if (type == "object" && !argument.isNull()) {
+        auto json = emscripten::val::global("JSON").call<std::string>("stringify", argument);
+        rapidjson::Document parsed;
+        parsed.Parse(json.c_str(), json.size());
+        if (!parsed.HasParseError())
+            result.CopyFrom(parsed, allocator);
+    }
+    return result;
+}
+
+} // namespace
+
+CommandDocument::PooledBuffer::PooledBuffer() {
+    auto& pool = bufferPool();
+    if (pool.empty()) {
+        mData.reset(new char[POOL_BUFFER_SIZE]);
+    } else {
+        mData = std::move(pool.back());
+        pool.pop_back();
+    }
+}
+
+CommandDocument::PooledBuffer::~PooledBuffer() {
+    auto& pool = bufferPool();
+    if (pool.size() < MAX_POOLED_BUFFERS)
+        pool.emplace_back(std::move(mData));
+}
+
+CommandDocument::CommandDocument()
+    : mAllocator(mBuffer.data(), POOL_BUFFER_SIZE),
+      mDocument(&mAllocator)
+{}
+
+CommandDocumentPtr
+CommandDocument::parse(const std::string& json) {
+    auto document = std::make_shared<CommandDocument>();
+    document->mDocument.Parse(json.c_str(), json.size());
+    return document;
+}
+
+CommandDocumentPtr
+CommandDocument::copy(const rapidjson::Value& value) {
+    auto document = std::make_shared<CommandDocument>();
+    document->mDocument.CopyFrom(value, document->mDocument.GetAllocator());
+    return document;
+}
+
+size_t
+CommandDocument::pooledBufferCount() {
+    return bufferPool().size();
+}
+
+CommandDocumentPtr
+CommandCache::get(const std::string& payload) {
+    if (payload.size() > MAX_CACHED_PAYLOAD)
+        return CommandDocument::parse(payload);
+
+    auto& state = cacheState();
+    auto hash = std::hash<std::string>()(payload);
+    auto it = state.index.find(hash);
+    if (it != state.index.end()) {
+        if (it->second->payload == payload) {
+            state.hits++;
+            state.entries.splice(state.entries.begin(), state.entries, it->second);
+            return it->second->document;
+        }
+        // Hash collision, the newer payload takes the slot
+        state.entries.erase(it->second);
+        state.index.erase(it);
+    }
+
+    state.misses++;
+    auto document = CommandDocument::parse(payload);
+    if (document->hasParseError())
+        return document;
+
+    state.entries.push_front({hash, payload, document});
+    state.index.emplace(hash, state.entries.begin());
+    trim(state);
+    return document;
+}
+
+void
+CommandCache::retain(const ActionPtr& action, const CommandDocumentPtr& document) {
+    if (!action)
+        return;
+
+    // The consumer is not required to add a "then" or "terminate" callback,
+    // so add them here to release the document
+    auto holder = std::make_shared<CommandDocumentPtr>(document);
+    action->then([holder](const ActionPtr&) { holder->reset(); });
+    action->addTerminateCallback([holder](const std::shared_ptr<Timers>&) { holder->reset(); });
+}
+
+bool
+CommandCache::registerTemplate(const std::string& name, const std::string& commands) {
+    auto document = CommandDocument::parse(commands);
+    if (document->hasParseError()) {
+        LOG(LogLevel::ERROR) << "Unable to parse command template " << name;
+        return false;
+    }
+
+    CommandTemplate commandTemplate;
+    commandTemplate.source = document;
+    findSlots(document->value(), rapidjson::Pointer(), commandTemplate.slots);
+    cacheState().templates[name] = std::move(commandTemplate);
+    return true;
+}
+
+bool
+CommandCache::unregisterTemplate(const std::string& name) {
+    return cacheState().templates.erase(name) > 0;
+}
+
+CommandDocumentPtr
+CommandCache::instantiate(const std::string& name, emscripten::val arguments) {
+    auto& templates = cacheState().templates;
+    auto it = templates.find(name);
+    if (it == templates.end()) {
+        LOG(LogLevel::ERROR) << "Unknown command template " << name;
+        return nullptr;
+    }
+
+    const auto& commandTemplate = it->second;
+    if (commandTemplate.slots.empty())
+        return commandTemplate.source;
+
+    auto document = CommandDocument::copy(commandTemplate.source->value());
+    auto& allocator = document->document().GetAllocator();
+    bool hasArguments = !arguments.isUndefined() && !arguments.isNull();
+    for (const auto& slot : commandTemplate.slots) {
+        auto target = slot.first.Get(document->document());
+        if (target)
+            *target = toJson(hasArguments ? arguments[slot.second] : emscripten::val::undefined(), allocator);
+    }
+    return document;
+}
+
+void
+CommandCache::clear() {
+    auto& state = cacheState();
+    state.entries.clear();
+    state.index.clear();
+}
+
+void
+CommandCache::setCapacity(size_t capacity) {
+    auto& state = cacheState();
+    state.capacity = capacity;
+    trim(state);
+}
+
+emscripten::val
+CommandCache::getStats() {
+    auto& state = cacheState();
+    auto stats = emscripten::val::object();
+    stats.set("hits", state.hits);
+    stats.set("misses", state.misses);
+    stats.set("entries", state.entries.size());
+    stats.set("templates", state.templates.size());
+    stats.set("pooledBuffers", CommandDocument::pooledBufferCount());
+    return stats;
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_command_cache) {
+
+    emscripten::class_<CommandCache>("CommandCache")
+        .class_function("registerTemplate", &CommandCache::registerTemplate)
+        .class_function("unregisterTemplate", &CommandCache::unregisterTemplate)
+        .class_function("clear", &CommandCache::clear)
+        .class_function("setCapacity", &CommandCache::setCapacity)
+        .class_function("getStats", &CommandCache::getStats);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -8,6 +8,7 @@
 
 #include "wasm/component.h"
 #include "wasm/embindutils.h"
+#include "wasm/contextstate.h"
 
 namespace apl {
 namespace wasm {
@@ -22,7 +23,7 @@ ComponentMethods::getDirtyProps(apl::ComponentPtr& component) {
     auto props = emscripten::val::object();
     for (PropertyKey key : keys) {
         auto value = calculated[key];
-        props.set(static_cast<int>(key), emscripten::getValFromObject(value, m));
+        props.set(static_cast<int>(key), emscripten::getValFromProperty(key, value, m));
     }
     return props;
 }
@@ -38,7 +39,19 @@ ComponentMethods::getCalculated(const apl::ComponentPtr& component) {
 emscripten::val
 ComponentMethods::getCalculatedByKey(const apl::ComponentPtr& component, int key) {
     auto m = component->getUserData<WASMMetrics>();
-    return emscripten::getValFromObject(component->getCalculated(static_cast<PropertyKey>(key)), m);
+    auto propertyKey = static_cast<PropertyKey>(key);
+    return emscripten::getValFromProperty(propertyKey, component->getCalculated(propertyKey), m);
+}
+
+double
+ComponentMethods::getCalculatedNumber(const apl::ComponentPtr& component, int key) {
+    auto m = component->getUserData<WASMMetrics>();
+    return emscripten::getNumberFromProperty(component->getCalculated(static_cast<PropertyKey>(key)), m);
+}
+
+uint32_t
+ComponentMethods::getCalculatedColor(const apl::ComponentPtr& component, int key) {
+    return component->getCalculated(static_cast<PropertyKey>(key)).asColor().get();
 }
 
 int
@@ -86,6 +99,10 @@ ComponentMethods::updateScrollPosition(apl::ComponentPtr& component, float scrol
     auto m = component->getUserData<WASMMetrics>();
     auto p = m->toCore(scrollPosition);
     component->update(kUpdateScrollPosition, p);
+
+    auto state = ContextState::find(m);
+    if (state)
+        state->getFetchWindow().observeScroll(component, p);
 }
 
 void
@@ -169,22 +186,14 @@ ComponentMethods::getBoundsInParent(const apl::ComponentPtr& component,
     }
 
     auto m = component->getUserData<WASMMetrics>();
-    auto x = m->toViewhost(rect.getX());
-    auto y = m->toViewhost(rect.getY());
-    auto w = m->toViewhost(rect.getWidth());
-    auto h = m->toViewhost(rect.getHeight());
-    return Rect(x, y, w, h);
+    return m->toViewhostRect(rect);
 }
 
 Rect
 ComponentMethods::getGlobalBounds(const apl::ComponentPtr& component) {
     auto rect = component->getGlobalBounds();
     auto m = component->getUserData<WASMMetrics>();
-    auto x = m->toViewhost(rect.getX());
-    auto y = m->toViewhost(rect.getY());
-    auto w = m->toViewhost(rect.getWidth());
-    auto h = m->toViewhost(rect.getHeight());
-    return Rect(x, y, w, h);
+    return m->toViewhostRect(rect);
 }
 
 void
@@ -211,6 +220,72 @@ ComponentMethods::getMediaPlayer(const apl::ComponentPtr& component) {
     return std::dynamic_pointer_cast<MediaPlayer>(video->getMediaPlayer());
 }
 
+emscripten::val
+ComponentMethods::snapshotSubtree(const apl::ComponentPtr& component, int maxDepth) {
+    auto m = component->getUserData<WASMMetrics>();
+
+    struct Node {
+        apl::ComponentPtr component;
+        int parent;
+        int depth;
+        int firstChild;
+    };
+
+    // Breadth first, so the nodes vector doubles as the traversal queue
+    std::vector<Node> nodes;
+    nodes.push_back({component, -1, 0, -1});
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (maxDepth >= 0 && nodes[i].depth >= maxDepth)
+            continue;
+        auto current = nodes[i].component;
+        auto childCount = current->getDisplayedChildCount();
+        if (childCount == 0)
+            continue;
+        nodes[i].firstChild = nodes.size();
+        auto depth = nodes[i].depth + 1;
+        for (size_t j = 0; j < childCount; j++) {
+            auto child = current->getDisplayedChildAt(j);
+            child->setUserData(m);
+            nodes.push_back({child, static_cast<int>(i), depth, -1});
+        }
+    }
+
+    auto count = nodes.size();
+    std::vector<int> structure;
+    structure.reserve(count * SNAPSHOT_NODE_SIZE);
+    auto components = emscripten::val::global("Array").new_(count);
+    auto uniqueIds = emscripten::val::global("Array").new_(count);
+    auto ids = emscripten::val::global("Array").new_(count);
+    auto props = emscripten::val::global("Array").new_(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto& node = nodes[i];
+        structure.push_back(node.parent);
+        structure.push_back(node.depth);
+        structure.push_back(static_cast<int>(node.component->getType()));
+        // Nodes cut off by maxDepth have no children listed, so report none
+        structure.push_back(node.firstChild < 0 ? 0 : node.component->getDisplayedChildCount());
+        structure.push_back(node.firstChild);
+
+        auto calculated = emscripten::val::object();
+        iterateProps(node.component->getCalculated(), calculated, m);
+        // A second wrapper of the root would only be one more handle for the caller to delete
+        components.set(i, i == 0 ? emscripten::val::null() : emscripten::val(node.component));
+        uniqueIds.set(i, node.component->getUniqueId());
+        ids.set(i, node.component->getId());
+        props.set(i, calculated);
+    }
+
+    auto snapshot = emscripten::val::object();
+    snapshot.set("count", count);
+    snapshot.set("nodes", emscripten::val::global("Int32Array").new_(
+        emscripten::typed_memory_view(structure.size(), structure.data())));
+    snapshot.set("components", components);
+    snapshot.set("uniqueIds", uniqueIds);
+    snapshot.set("ids", ids);
+    snapshot.set("props", props);
+    return snapshot;
+}
+
 } // namespace internal
 
 EMSCRIPTEN_BINDINGS(apl_wasm_component) {
@@ -222,6 +297,8 @@ EMSCRIPTEN_BINDINGS(apl_wasm_component) {
         .smart_ptr<std::shared_ptr<apl::Component>>("ComponentPtr")
         .function("getCalculated", &internal::ComponentMethods::getCalculated)
         .function("getCalculatedByKey", &internal::ComponentMethods::getCalculatedByKey)
+        .function("getCalculatedNumber", &internal::ComponentMethods::getCalculatedNumber)
+        .function("getCalculatedColor", &internal::ComponentMethods::getCalculatedColor)
         .function("getDirtyProps", &internal::ComponentMethods::getDirtyProps)
         .function("getType", &internal::ComponentMethods::getType)
         .function("getUniqueId", &internal::ComponentMethods::getUniqueId)
@@ -248,7 +325,8 @@ EMSCRIPTEN_BINDINGS(apl_wasm_component) {
         .function("getDisplayedChildCount", &internal::ComponentMethods::getDisplayedChildCount)
         .function("getDisplayedChildId", &internal::ComponentMethods::getDisplayedChildId)
         .function("getDisplayedChildAt", &internal::ComponentMethods::getDisplayedChildAt)
-        .function("getMediaPlayer", &internal::ComponentMethods::getMediaPlayer);
+        .function("getMediaPlayer", &internal::ComponentMethods::getMediaPlayer)
+        .function("snapshotSubtree", &internal::ComponentMethods::snapshotSubtree);
 }
 
 } // namespace wasm
@@ -0,0 +1,111 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/componentregistry.h"
+#include "apl/utils/log.h"
+#include <algorithm>
+
+namespace apl {
+namespace wasm {
+
+// Bound by reference in std::min and std::max
+const size_t ComponentRegistry::MIN_SWEEP_SIZE;
+const size_t ComponentRegistry::RELEASE_SCAN_SIZE;
+
+int
+ComponentRegistry::handleFor(const ComponentPtr& component) {
+    if (!component)
+        return INVALID_HANDLE;
+
+    auto it = mIndex.find(component.get());
+    if (it != mIndex.end()) {
+        const auto& slot = mSlots[it->second];
+        if (slot.component.lock() == component)
+            return toHandle(it->second, slot.generation);
+
+        // The address belonged to a component that has been destroyed since
+        release(it->second);
+    }
+
+    if (mFree.empty() && mSlots.size() >= mSweepSize)
+        sweep();
+
+    int index;
+    if (!mFree.empty()) {
+        index = mFree.back();
+        mFree.pop_back();
+    } else if (mSlots.size() < static_cast<size_t>(MAX_SLOTS)) {
+        index = mSlots.size();
+        mSlots.emplace_back();
+    } else {
+        LOG(LogLevel::ERROR) << "Component registry is full";
+        return INVALID_HANDLE;
+    }
+
+    auto& slot = mSlots[index];
+    slot.component = component;
+    slot.address = component.get();
+    mIndex.emplace(slot.address, index);
+
+    // Children reached through handles never pass through the wrappers that propagate metrics
+    component->setUserData(mMetrics);
+    return toHandle(index, slot.generation);
+}
+
+ComponentPtr
+ComponentRegistry::get(int handle) const {
+    if (handle < 0)
+        return nullptr;
+    auto index = handle & (MAX_SLOTS - 1);
+    if (index >= static_cast<int>(mSlots.size()))
+        return nullptr;
+
+    // A handle of an earlier generation names a component that has been released
+    const auto& slot = mSlots[index];
+    if (toHandle(index, slot.generation) != handle)
+        return nullptr;
+    return slot.component.lock();
+}
+
+std::vector<int>
+ComponentRegistry::collectReleased() {
+    auto count = std::min(RELEASE_SCAN_SIZE, mSlots.size());
+    for (size_t i = 0; i < count; i++) {
+        if (mScanPosition >= mSlots.size())
+            mScanPosition = 0;
+        const auto& slot = mSlots[mScanPosition];
+        if (slot.address && slot.component.expired())
+            release(mScanPosition);
+        mScanPosition++;
+    }
+
+    std::vector<int> released;
+    released.swap(mReleased);
+    return released;
+}
+
+void
+ComponentRegistry::sweep() {
+    for (int index = 0; index < static_cast<int>(mSlots.size()); index++) {
+        const auto& slot = mSlots[index];
+        if (slot.address && slot.component.expired())
+            release(index);
+    }
+    mSweepSize = std::max(MIN_SWEEP_SIZE, 2 * mIndex.size());
+}
+
+void
+ComponentRegistry::release(int index) {
+    auto& slot = mSlots[index];
+    mReleased.push_back(toHandle(index, slot.generation));
+    mIndex.erase(slot.address);
+    slot.component.reset();
+    slot.address = nullptr;
+    slot.generation = (slot.generation + 1) & GENERATION_MASK;
+    mFree.push_back(index);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -4,13 +4,46 @@
  */
 
 #include "wasm/content.h"
+#include "wasm/contentdata.h"
 #include "wasm/embindutils.h"
+#include "wasm/jsonbuffer.h"
+#include "wasm/packagecache.h"
 
 namespace apl {
 namespace wasm {
 
 namespace internal {
 
+namespace {
+
+/**
+ * Hand core the data of a buffer. Empty data stands in for a buffer that could not be read, so
+ * core puts the content in error rather than waiting for the parameter.
+ */
+bool
+addParsedData(const apl::ContentPtr& content, const std::string& name,
+              const std::shared_ptr<rapidjson::Document>& json) {
+    if (!json) {
+        content->addData(name, "");
+        return false;
+    }
+    ContentData::add(content, name, json);
+    return !json->HasParseError();
+}
+
+bool
+addParsedPackage(const apl::ContentPtr& content, const apl::ImportRequest& request,
+                 const std::shared_ptr<rapidjson::Document>& json) {
+    if (!json) {
+        content->addPackage(request, "");
+        return false;
+    }
+    content->addPackage(request, JsonData(json));
+    return !json->HasParseError();
+}
+
+} // namespace
+
 apl::ContentPtr
 ContentMethods::create(const std::string& document, const SessionPtr& session) {
     return apl::Content::create(document.c_str(), session);
@@ -22,6 +55,40 @@ ContentMethods::createWithConfig(const std::string& document, const SessionPtr&
     return apl::Content::create(document.c_str(), session, metrics, config);
 }
 
+apl::ContentPtr
+ContentMethods::createFromBuffer(uintptr_t document, size_t length, const SessionPtr& session) {
+    auto json = JsonBuffer::parse(document, length);
+    if (!json)
+        return nullptr;
+    return apl::Content::create(JsonData(json), session);
+}
+
+apl::ContentPtr
+ContentMethods::createFromBufferWithConfig(uintptr_t document, size_t length, const SessionPtr& session,
+                                           const Metrics& metrics, const RootConfig& config) {
+    auto json = JsonBuffer::parse(document, length);
+    if (!json)
+        return nullptr;
+    return apl::Content::create(JsonData(json), session, metrics, config);
+}
+
+apl::ContentPtr
+ContentMethods::createFromCompressedBuffer(uintptr_t document, size_t length, const SessionPtr& session) {
+    auto json = JsonBuffer::parseCompressed(document, length);
+    if (!json)
+        return nullptr;
+    return apl::Content::create(JsonData(json), session);
+}
+
+apl::ContentPtr
+ContentMethods::createFromCompressedBufferWithConfig(uintptr_t document, size_t length, const SessionPtr& session,
+                                                     const Metrics& metrics, const RootConfig& config) {
+    auto json = JsonBuffer::parseCompressed(document, length);
+    if (!json)
+        return nullptr;
+    return apl::Content::create(JsonData(json), session, metrics, config);
+}
+
 void
 ContentMethods::refresh(const apl::ContentPtr& content, const Metrics& metrics, const RootConfig& config) {
     content->refresh(metrics, config);
@@ -38,6 +105,26 @@ ContentMethods::getRequestedPackages(const apl::ContentPtr& content) {
     return content->getRequestedPackages();
 }
 
+emscripten::val
+ContentMethods::getPrefetchImports(const apl::ContentPtr& content) {
+    std::vector<std::string> roots;
+    for (const auto& request : content->getRequestedPackages())
+        roots.push_back(PackageCache::key(request));
+
+    auto result = emscripten::val::array();
+    auto imports = PackageCache::transitiveImports(roots);
+    for (size_t i = 0; i < imports.size(); i++) {
+        auto value = emscripten::val::object();
+        value.set("reference", PackageCache::key(imports[i]));
+        value.set("name", imports[i].name);
+        value.set("version", imports[i].version);
+        value.set("source", imports[i].source);
+        value.set("domain", imports[i].domain);
+        result.set(i, value);
+    }
+    return result;
+}
+
 bool
 ContentMethods::isError(const apl::ContentPtr& content) {
     return content->isError();
@@ -55,7 +142,34 @@ ContentMethods::isWaiting(const apl::ContentPtr& content) {
 
 void
 ContentMethods::addData(const apl::ContentPtr& content, const std::string& name, const std::string& data) {
-    content->addData(name, data.c_str());
+    // Parsed here rather than by core, so the document is recorded with the content. Data that
+    // does not parse goes to core as is, to be reported there.
+    auto json = std::make_shared<rapidjson::Document>();
+    json->Parse(data.c_str(), data.size());
+    if (json->HasParseError())
+        content->addData(name, data.c_str());
+    else
+        ContentData::add(content, name, json);
+}
+
+bool
+ContentMethods::addDataFromBuffer(const apl::ContentPtr& content, const std::string& name, uintptr_t data,
+                                  size_t length) {
+    return addParsedData(content, name, JsonBuffer::parse(data, length));
+}
+
+bool
+ContentMethods::addDataFromCompressedBuffer(const apl::ContentPtr& content, const std::string& name, uintptr_t data,
+                                            size_t length) {
+    return addParsedData(content, name, JsonBuffer::parseCompressed(data, length));
+}
+
+emscripten::val
+ContentMethods::copyData(const apl::ContentPtr& content, const apl::ContentPtr& other) {
+    auto result = emscripten::val::array();
+    for (const auto& name : ContentData::copy(content, other))
+        result.call<void>("push", name);
+    return result;
 }
 
 std::string
@@ -69,6 +183,18 @@ ContentMethods::addPackage(const apl::ContentPtr& content, const apl::ImportRequ
     content->addPackage(request, data.c_str());
 }
 
+bool
+ContentMethods::addPackageFromBuffer(const apl::ContentPtr& content, const apl::ImportRequest& request,
+                                     uintptr_t data, size_t length) {
+    return addParsedPackage(content, request, JsonBuffer::parse(data, length));
+}
+
+bool
+ContentMethods::addPackageFromCompressedBuffer(const apl::ContentPtr& content, const apl::ImportRequest& request,
+                                               uintptr_t data, size_t length) {
+    return addParsedPackage(content, request, JsonBuffer::parseCompressed(data, length));
+}
+
 /**
  * @return The set of requested custom extensions (a list of URI values)
  */
@@ -107,15 +233,26 @@ EMSCRIPTEN_BINDINGS(apl_wasm_content) {
     emscripten::class_<apl::Content>("Content")
         .class_function("create", &internal::ContentMethods::create)
         .class_function("createWithConfig", &internal::ContentMethods::createWithConfig)
+        .class_function("createFromBuffer", &internal::ContentMethods::createFromBuffer)
+        .class_function("createFromBufferWithConfig", &internal::ContentMethods::createFromBufferWithConfig)
+        .class_function("createFromCompressedBuffer", &internal::ContentMethods::createFromCompressedBuffer)
+        .class_function("createFromCompressedBufferWithConfig",
+                        &internal::ContentMethods::createFromCompressedBufferWithConfig)
         .smart_ptr<apl::ContentPtr>("ContentPtr")
         .function("refresh", &internal::ContentMethods::refresh)
         .function("load", &internal::ContentMethods::load)
         .function("getRequestedPackages", &internal::ContentMethods::getRequestedPackages)
+        .function("getPrefetchImports", &internal::ContentMethods::getPrefetchImports)
         .function("isError", &internal::ContentMethods::isError)
         .function("isReady", &internal::ContentMethods::isReady)
         .function("isWaiting", &internal::ContentMethods::isWaiting)
         .function("addData", &internal::ContentMethods::addData)
         .function("addPackage", &internal::ContentMethods::addPackage)
+        .function("addDataFromBuffer", &internal::ContentMethods::addDataFromBuffer)
+        .function("addPackageFromBuffer", &internal::ContentMethods::addPackageFromBuffer)
+        .function("addDataFromCompressedBuffer", &internal::ContentMethods::addDataFromCompressedBuffer)
+        .function("addPackageFromCompressedBuffer", &internal::ContentMethods::addPackageFromCompressedBuffer)
+        .function("copyData", &internal::ContentMethods::copyData)
         .function("getAPLVersion", &internal::ContentMethods::getAPLVersion)
         .function("getExtensionRequests", &internal::ContentMethods::getExtensionRequests)
         .function("getExtensionSettings", &internal::ContentMethods::getExtensionSettings)
@@ -0,0 +1,100 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/contentdata.h"
+#include "apl/content/jsondata.h"
+#include "apl/utils/log.h"
+#include <algorithm>
+#include <map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const char* PAYLOAD = "payload";
+
+struct Entry {
+    std::weak_ptr<Content> content;
+    std::vector<std::pair<std::string, std::weak_ptr<rapidjson::Document>>> data;
+};
+
+std::map<const Content*, Entry>&
+registry() {
+    static std::map<const Content*, Entry> sRegistry;
+    return sRegistry;
+}
+
+} // namespace
+
+void
+ContentData::add(const ContentPtr& content, const std::string& name,
+                 const std::shared_ptr<rapidjson::Document>& data) {
+    content->addData(name, JsonData(data));
+
+    // Released contents are dropped first, their addresses may be reused
+    auto& entries = registry();
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.content.expired())
+            it = entries.erase(it);
+        else
+            ++it;
+    }
+
+    auto& entry = entries[content.get()];
+    entry.content = content;
+    entry.data.emplace_back(name, data);
+}
+
+ContentData::DataList
+ContentData::get(const ContentPtr& content) {
+    DataList result;
+    auto& entries = registry();
+    auto it = entries.find(content.get());
+    if (it == entries.end() || it->second.content.lock() != content)
+        return result;
+
+    for (const auto& data : it->second.data) {
+        auto document = data.second.lock();
+        if (document)
+            result.emplace_back(data.first, document);
+        else
+            LOG(LogLevel::WARN) << "Data source " << data.first << " is no longer held by its content";
+    }
+    return result;
+}
+
+std::vector<std::string>
+ContentData::copy(const ContentPtr& content, const ContentPtr& other) {
+    std::vector<std::string> names;
+    std::shared_ptr<rapidjson::Document> payload;
+    for (const auto& data : get(other)) {
+        add(content, data.first, data.second);
+        names.push_back(data.first);
+        if (data.first == PAYLOAD)
+            payload = data.second;
+    }
+
+    if (!payload || !payload->IsObject())
+        return names;
+
+    for (size_t i = 0; i < content->getParameterCount(); i++) {
+        std::string name = content->getParameterAt(i);
+        if (std::find(names.begin(), names.end(), name) != names.end())
+            continue;
+        auto member = payload->FindMember(name.c_str());
+        if (member == payload->MemberEnd() || member->value.IsNull())
+            continue;
+
+        auto data = std::make_shared<rapidjson::Document>();
+        data->CopyFrom(member->value, data->GetAllocator());
+        add(content, name, data);
+        names.push_back(name);
+    }
+    return names;
+}
+
+} // namespace wasm
+} // namespace apl
@@ -7,12 +7,21 @@
 #include "apl/apl.h"
 #include "apl/dynamicdata.h"
 #include "wasm/textmeasurement.h"
+#include "wasm/nativetextmeasurement.h"
+#include "wasm/commandcache.h"
+#include "wasm/contextstate.h"
+#include "wasm/audioplayerfactory.h"
+#include "wasm/keytable.h"
+#include "wasm/rootconfig.h"
+#include "wasm/event.h"
+#include "wasm/jsonbridge.h"
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include "wasm/embindutils.h"
 #include "wasm/session.h"
 #include "utils/jsparser.h"
 #include <climits>
+#include <cstdint>
 
 namespace apl {
 namespace wasm {
@@ -23,16 +32,203 @@ static const size_t DEFAULT_DATA_SOURCE_CACHE_CHUNK_SIZE = 10;
 static const std::string DYNAMIC_INDEX_LIST = "dynamicIndexList";
 static const std::string DYNAMIC_TOKEN_LIST = "dynamicTokenList";
 static const std::vector<std::string> KNOWN_DATA_SOURCES = { DYNAMIC_INDEX_LIST, DYNAMIC_TOKEN_LIST };
-static emscripten::val background = emscripten::val::object();
+
+/**
+ * Session of the throwaway inflation that collects batched text measurements, which drops what
+ * the real inflation reports again.
+ */
+class ProbeSession : public apl::Session {
+public:
+    void write(const char *filename, const char *func, const char *value) override {}
+    void write(apl::LogCommandMessage&& message) override {}
+};
+
+/**
+ * Configuration of the throwaway inflation: the document configuration without anything that
+ * reaches outside of the inflation, so data source connections, fetch requests, audio players,
+ * embedded document requests and session logs only come from the real inflation.
+ */
+static RootConfig
+probeConfig(const RootConfig& rootConfig) {
+    RootConfig config = rootConfig;
+    config.session(std::make_shared<ProbeSession>())
+        .dataSourceProvider(DYNAMIC_INDEX_LIST, nullptr)
+        .dataSourceProvider(DYNAMIC_TOKEN_LIST, nullptr)
+        .audioPlayerFactory(nullptr)
+        .documentManager(nullptr);
+    return config;
+}
+
+/**
+ * Convert a byte budget from JS. Negative and NaN budgets are 0 and huge ones saturate, where a
+ * plain cast to size_t would be undefined.
+ */
+static size_t
+toByteBudget(double byteBudget) {
+    if (!(byteBudget > 0))
+        return 0;
+    if (byteBudget >= static_cast<double>(SIZE_MAX))
+        return SIZE_MAX;
+    return static_cast<size_t>(byteBudget);
+}
+
+/**
+ * Hand an update to the provider of its type, whichever kind of list it serves. Core parses the
+ * payload, so the provider holds on to a document it owns.
+ */
+static bool
+applyDataSourceUpdate(const apl::RootContextPtr& context, const std::string& type, const std::string& payload) {
+    auto provider = context->getRootConfig().getDataSourceProvider(type);
+    if (!provider || !provider->processUpdate(payload))
+        return false;
+
+    auto state = ContextState::get(context);
+    if (state && state->getFetchWindow().isEnabled() && type == DYNAMIC_INDEX_LIST)
+        state->getFetchWindow().complete(payload);
+    return true;
+}
+
+static emscripten::val
+toInt32Array(const std::vector<int>& values) {
+    // Copied out of the heap, so the result survives memory growth and later calls
+    return emscripten::val::global("Int32Array").new_(emscripten::typed_memory_view(values.size(), values.data()));
+}
 
 apl::ComponentPtr
 ContextMethods::topComponent(const apl::RootContextPtr& context) {
     // pass along the metrics user data
     auto top = context->topComponent();
     top->setUserData(context->getUserData());
+    auto state = ContextState::get(context);
+    if (state)
+        state->retainTree(top);
     return top;
 }
 
+int
+ContextMethods::getComponentHandle(const apl::RootContextPtr& context, const apl::ComponentPtr& component) {
+    auto state = ContextState::get(context);
+    return state ? state->getComponents().handleFor(component) : ComponentRegistry::INVALID_HANDLE;
+}
+
+int
+ContextMethods::getTopComponentHandle(const apl::RootContextPtr& context) {
+    auto state = ContextState::get(context);
+    if (!state)
+        return ComponentRegistry::INVALID_HANDLE;
+    auto top = context->topComponent();
+    state->retainTree(top);
+    return state->getComponents().handleFor(top);
+}
+
+apl::ComponentPtr
+ContextMethods::getComponentByHandle(const apl::RootContextPtr& context, int handle) {
+    auto state = ContextState::get(context);
+    return state ? state->getComponents().get(handle) : nullptr;
+}
+
+int
+ContextMethods::getParentHandle(const apl::RootContextPtr& context, int handle) {
+    auto state = ContextState::get(context);
+    if (!state)
+        return ComponentRegistry::INVALID_HANDLE;
+    auto& components = state->getComponents();
+    auto component = components.get(handle);
+    return component ? components.handleFor(component->getParent()) : ComponentRegistry::INVALID_HANDLE;
+}
+
+emscripten::val
+ContextMethods::getChildHandles(const apl::RootContextPtr& context, int handle) {
+    auto state = ContextState::get(context);
+    std::vector<int> handles;
+    if (!state)
+        return toInt32Array(handles);
+    auto& components = state->getComponents();
+    if (auto component = components.get(handle)) {
+        handles.reserve(component->getChildCount());
+        for (size_t i = 0; i < component->getChildCount(); i++)
+            handles.push_back(components.handleFor(component->getChildAt(i)));
+    }
+    return toInt32Array(handles);
+}
+
+emscripten::val
+ContextMethods::getDisplayedChildHandles(const apl::RootContextPtr& context, int handle) {
+    auto state = ContextState::get(context);
+    std::vector<int> handles;
+    if (!state)
+        return toInt32Array(handles);
+    auto& components = state->getComponents();
+    if (auto component = components.get(handle)) {
+        handles.reserve(component->getDisplayedChildCount());
+        for (size_t i = 0; i < component->getDisplayedChildCount(); i++)
+            handles.push_back(components.handleFor(component->getDisplayedChildAt(i)));
+    }
+    return toInt32Array(handles);
+}
+
+emscripten::val
+ContextMethods::getComponentTypes(const apl::RootContextPtr& context, emscripten::val handles) {
+    auto state = ContextState::get(context);
+    std::vector<int> types;
+    if (!state)
+        return toInt32Array(types);
+    auto& components = state->getComponents();
+    auto input = emscripten::convertJSArrayToNumberVector<int>(handles);
+    types.reserve(input.size());
+    for (auto handle : input) {
+        auto component = components.get(handle);
+        types.push_back(component ? static_cast<int>(component->getType()) : -1);
+    }
+    return toInt32Array(types);
+}
+
+emscripten::val
+ContextMethods::getGlobalBoundsForHandles(const apl::RootContextPtr& context, emscripten::val handles) {
+    auto state = ContextState::get(context);
+    std::vector<double> bounds;
+    if (!state)
+        return emscripten::val::global("Float64Array").new_(0);
+    auto& components = state->getComponents();
+    auto m = state->getMetrics();
+    auto input = emscripten::convertJSArrayToNumberVector<int>(handles);
+    bounds.reserve(input.size() * 4);
+    for (auto handle : input) {
+        auto component = components.get(handle);
+        auto rect = component ? m->toViewhostRect(component->getGlobalBounds()) : Rect();
+        bounds.push_back(rect.getX());
+        bounds.push_back(rect.getY());
+        bounds.push_back(rect.getWidth());
+        bounds.push_back(rect.getHeight());
+    }
+    return emscripten::val::global("Float64Array").new_(emscripten::typed_memory_view(bounds.size(), bounds.data()));
+}
+
+emscripten::val
+ContextMethods::getCalculatedForHandles(const apl::RootContextPtr& context, emscripten::val handles, int key) {
+    auto state = ContextState::get(context);
+    auto values = emscripten::val::array();
+    if (!state)
+        return values;
+    auto& components = state->getComponents();
+    auto m = state->getMetrics();
+    auto propertyKey = static_cast<PropertyKey>(key);
+    auto input = emscripten::convertJSArrayToNumberVector<int>(handles);
+    for (size_t i = 0; i < input.size(); i++) {
+        auto component = components.get(input[i]);
+        values.set(i, component
+                      ? emscripten::getValFromProperty(propertyKey, component->getCalculated(propertyKey), m)
+                      : emscripten::val::undefined());
+    }
+    return values;
+}
+
+emscripten::val
+ContextMethods::collectReleasedHandles(const apl::RootContextPtr& context) {
+    auto state = ContextState::get(context);
+    return toInt32Array(state ? state->getComponents().collectReleased() : std::vector<int>());
+}
+
 apl::DocumentContextPtr
 ContextMethods::topDocument(const apl::RootContextPtr& context) {
     return context->topDocument();
@@ -40,12 +236,16 @@ ContextMethods::topDocument(const apl::RootContextPtr& context) {
 
 emscripten::val
 ContextMethods::getBackground(const apl::RootContextPtr& context) {
-    return background;
+    auto state = ContextState::get(context);
+    return state ? state->getBackground() : emscripten::val::object();
 }
 
 void
 ContextMethods::setBackground(const apl::RootContextPtr& context, emscripten::val bg) {
-    background = bg;
+    auto state = ContextState::get(context);
+    if (state) {
+        state->setBackground(bg);
+    }
 }
 
 std::string
@@ -81,6 +281,24 @@ ContextMethods::getVisualContext(const apl::RootContextPtr& context) {
     return buffer.GetString();
 }
 
+emscripten::val
+ContextMethods::getDocumentStateAs(const apl::RootContextPtr& context, int mode) {
+    rapidjson::Document document(rapidjson::kObjectType);
+    return JsonBridge::convert(context->serializeDocumentState(document.GetAllocator()), mode);
+}
+
+emscripten::val
+ContextMethods::getDataSourceContextAs(const apl::RootContextPtr& context, int mode) {
+    rapidjson::Document document(rapidjson::kObjectType);
+    return JsonBridge::convert(context->serializeDataSourceContext(document.GetAllocator()), mode);
+}
+
+emscripten::val
+ContextMethods::getVisualContextAs(const apl::RootContextPtr& context, int mode) {
+    rapidjson::Document state(rapidjson::kObjectType);
+    return JsonBridge::convert(context->serializeVisualContext(state.GetAllocator()), mode);
+}
+
 void
 ContextMethods::clearPending(const apl::RootContextPtr& context) {
     context->clearPending();
@@ -106,60 +324,46 @@ ContextMethods::getDirty(const apl::RootContextPtr& context) {
     return dirtyComponentIds;
 }
 
+emscripten::val
+ContextMethods::collectFrameDelta(const apl::RootContextPtr& context) {
+    auto m = context->getUserData<WASMMetrics>();
+    auto state = ContextState::get(context);
+    return state ? state->getFrameDelta().collect(context->getDirty(), m) : emscripten::val::null();
+}
+
 void
 ContextMethods::scrollToRectInComponent(const apl::RootContextPtr& context, const apl::ComponentPtr& component,
                                         int x, int y, int width, int height, int align) {
     auto t = context->getUserData<WASMMetrics>();
-    float scale = t->toCore(1.0f);
+    float scale = t->getCoreScale();
     Rect rect(x * scale, y * scale, width * scale, height * scale);
     context->scrollToRectInComponent(component, rect, static_cast<CommandScrollAlign>(align));
 }
 
 apl::ActionPtr
 ContextMethods::executeCommands(const apl::RootContextPtr& context, const std::string& commands) {
-    auto* doc = new rapidjson::Document();
-    doc->Parse(commands.c_str());
-    apl::Object obj = apl::Object(*doc);
-    auto action = context->executeCommands(obj, false);
-    action->setUserData(doc);
-    // The consumer is not required to add a "then" or "terminate" callback,
-    // so add them here to clean up the document
-    action->then([doc](const ActionPtr& action) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
-    action->addTerminateCallback([doc, action](const std::shared_ptr<Timers>&) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
+    auto document = CommandCache::get(commands);
+    auto action = context->executeCommands(apl::Object(document->value()), false);
+    CommandCache::retain(action, document);
+    return action;
+}
+
+apl::ActionPtr
+ContextMethods::executeCommandTemplate(const apl::RootContextPtr& context, const std::string& name, emscripten::val arguments) {
+    auto document = CommandCache::instantiate(name, arguments);
+    if (!document)
+        return nullptr;
+    auto action = context->executeCommands(apl::Object(document->value()), false);
+    CommandCache::retain(action, document);
     return action;
 }
 
 apl::ActionPtr
 ContextMethods::invokeExtensionEventHandler(const apl::RootContextPtr& context, const std::string& uri, const std::string& name, const std::string& data, bool fastMode) {
-    auto* doc = new rapidjson::Document();
-    doc->Parse(data.c_str());
-    apl::Object obj = apl::Object(*doc);
+    auto document = CommandCache::get(data);
+    apl::Object obj = apl::Object(document->value());
     auto action = context->invokeExtensionEventHandler(uri, name, obj.getMap(), false);
-    action->setUserData(doc);
-    // The consumer is not required to add a "then" or "terminate" callback,
-    // so add them here to clean up the document
-    action->then([doc](const ActionPtr& action) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
-    action->addTerminateCallback([doc, action](const std::shared_ptr<Timers>&) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
+    CommandCache::retain(action, document);
     return action;
 }
 
@@ -208,11 +412,16 @@ apl::RootContextPtr
 ContextMethods::create(emscripten::val options, emscripten::val text, emscripten::val metrics, emscripten::val content, emscripten::val config, emscripten::val scalingOptions) {
     try {
         auto coreMetrics = *(metrics.as<std::shared_ptr<Metrics>>());
-        auto rootConfig = *(config.as<std::shared_ptr<RootConfig>>());
-
-        // Add Data Sources
-        rootConfig.dataSourceProvider(DYNAMIC_INDEX_LIST, std::make_shared<DynamicIndexListDataSourceProvider>(DYNAMIC_INDEX_LIST,
-            DEFAULT_DATA_SOURCE_CACHE_CHUNK_SIZE));
+        auto rootConfigPtr = config.as<std::shared_ptr<RootConfig>>();
+        auto rootConfig = *rootConfigPtr;
+
+        // Add Data Sources, with the configuration set through RootConfig.dynamicIndexListConfiguration if any
+        auto indexListProvider = RootConfigMethods::createDynamicIndexListProvider(rootConfigPtr);
+        if (!indexListProvider) {
+            indexListProvider = std::make_shared<DynamicIndexListDataSourceProvider>(DYNAMIC_INDEX_LIST,
+                DEFAULT_DATA_SOURCE_CACHE_CHUNK_SIZE);
+        }
+        rootConfig.dataSourceProvider(DYNAMIC_INDEX_LIST, indexListProvider);
         rootConfig.dataSourceProvider(DYNAMIC_TOKEN_LIST, std::make_shared<DynamicTokenListDataSourceProvider>());
 
         // Other options
@@ -234,26 +443,54 @@ ContextMethods::create(emscripten::val options, emscripten::val text, emscripten
             );
         }
 
+        bool batchTextMeasurement = !options.isUndefined() && !options.isNull() &&
+                                    options["batchTextMeasurement"].isTrue() &&
+                                    !text.isUndefined() && !text["onMeasureBatch"].isUndefined();
+
         apl::RootContextPtr root;
-        WASMMetrics* m;
+        std::unique_ptr<WASMMetrics> m;
+        std::shared_ptr<WasmTextMeasurement> textMeasure;
         do {
             if (!scalingOptions.isUndefined()) {
                 ScalingOptions so(specs, k, shapeOverridesCost);
-                m = new WASMMetrics(coreMetrics, so);
+                m.reset(new WASMMetrics(coreMetrics, so));
             }
             else {
-                m = new WASMMetrics(coreMetrics);
+                m.reset(new WASMMetrics(coreMetrics));
             }
 
             // set apl renderer callbacks
-            if (!text.isUndefined()) {
+            bool nativeMeasure = std::dynamic_pointer_cast<NativeTextMeasurement>(rootConfig.getMeasure()) != nullptr;
+            if (!text.isUndefined() && !nativeMeasure) {
                 auto onMeasure = text["onMeasure"].call<emscripten::val>("bind", text);
-                auto textMeasure = std::make_shared<WasmTextMeasurement>(onMeasure, m);
+                auto onMeasureBatch = batchTextMeasurement
+                    ? text["onMeasureBatch"].call<emscripten::val>("bind", text)
+                    : emscripten::val::undefined();
+                textMeasure = std::make_shared<WasmTextMeasurement>(onMeasure, m.get(), onMeasureBatch);
+                if (!options.isUndefined() && !options.isNull()) {
+                    textMeasure->getCache().setByteBudget(toByteBudget(jsparser::getOptionalValue(
+                        options, "textMeasurementCacheBudget",
+                        static_cast<double>(TextLayoutCache::DEFAULT_BYTE_BUDGET))));
+                }
+                rootConfig.measure(textMeasure);
+            }
+            if (!text.isUndefined()) {
                 auto onPEGTLError = text["onPEGTLError"].call<emscripten::val>("bind", text);
                 auto wasmSession = std::make_shared<WasmSession>(onPEGTLError);
-                rootConfig.measure(textMeasure);
                 rootConfig.session(wasmSession);
             }
+
+            // Core measures synchronously, so batching takes a throwaway inflation to collect every
+            // text measurement, one batch call to measure them, and a real inflation that reads
+            // the results from the layout cache. The throwaway inflation runs with a stripped
+            // configuration; measurements it did not see are made synchronously as before.
+            if (textMeasure && textMeasure->canBatch()) {
+                textMeasure->beginBatch();
+                {
+                    auto probe = RootContext::create(m->getMetrics(), contentPtr, probeConfig(rootConfig));
+                }
+                textMeasure->resolveBatch();
+            }
             root = RootContext::create(m->getMetrics(), contentPtr, rootConfig);
             if(root) break;
             else {
@@ -275,18 +512,32 @@ ContextMethods::create(emscripten::val options, emscripten::val text, emscripten
             }
         } while(!specs.empty());
 
+        if (!root) {
+            return nullptr;
+        }
+
+        // add metrics to the root context so we can connect our viewport to any events, components,
+        // or graphic elements for scaling.
+        root->setUserData(m.get());
+        auto& state = ContextState::create(root, std::move(m), textMeasure);
+        bool hasOptions = !options.isUndefined() && !options.isNull();
+        state.setDecodeEvents(hasOptions && options["decodeEvents"].isTrue());
+        if (hasOptions) {
+            state.getFetchWindow().setMaxWindow(jsparser::getOptionalValue(options, "maxFetchWindow", 0));
+            if (state.getFetchWindow().isEnabled())
+                state.getFetchWindow().adoptBounds(contentPtr);
+        }
+
         // get document background, color or gradient
+        auto& background = state.getBackground();
         background.set("color", emscripten::val(Color().asString())); // Transparent
         background.set("gradient", emscripten::val::null());
         if (contentPtr->getBackground(coreMetrics, rootConfig).is<Color>()) {
             background.set("color", emscripten::val(contentPtr->getBackground(coreMetrics, rootConfig).asColor().asString()));
         } else if (contentPtr->getBackground(coreMetrics, rootConfig).is<Gradient>()) {
-            background.set("gradient", emscripten::getValFromObject(contentPtr->getBackground(coreMetrics, rootConfig).get<Gradient>(), m));
+            background.set("gradient", emscripten::getValFromObject(contentPtr->getBackground(coreMetrics, rootConfig).get<Gradient>(), state.getMetrics()));
         }
 
-        // add metrics to the root context so we can connect our viewport to any events, components,
-        // or graphic elements for scaling.
-        root->setUserData(m);
         // this has to be called to set mCore->top
         root->topComponent();
         return root;
@@ -298,8 +549,17 @@ ContextMethods::create(emscripten::val options, emscripten::val text, emscripten
     }
 }
 
-emscripten::val
-ContextMethods::getPendingErrors(const apl::RootContextPtr& context) {
+/**
+ * Release the binding state of the context: component handles, event tokens, frame buffers and
+ * the fetch window. The context is not usable through the bindings afterwards.
+ */
+void
+ContextMethods::destroy(const apl::RootContextPtr& context) {
+    ContextState::release(context);
+}
+
+apl::Object
+ContextMethods::collectPendingErrors(const apl::RootContextPtr& context) {
     std::vector<apl::Object> errorArray;
 
     for (auto& type : KNOWN_DATA_SOURCES) {
@@ -313,10 +573,13 @@ ContextMethods::getPendingErrors(const apl::RootContextPtr& context) {
         }
     }
 
-    auto errors = apl::Object(std::make_shared<apl::ObjectArray>(errorArray));
+    return apl::Object(std::make_shared<apl::ObjectArray>(errorArray));
+}
 
+emscripten::val
+ContextMethods::getPendingErrors(const apl::RootContextPtr& context) {
     auto m = context->getUserData<WASMMetrics>();
-    return emscripten::getValFromObject(errors, m);
+    return emscripten::getValFromObject(collectPendingErrors(context), m);
 }
 
 bool
@@ -331,6 +594,70 @@ ContextMethods::popEvent(const apl::RootContextPtr& context) {
     return event;
 }
 
+emscripten::val
+ContextMethods::drainEvents(const apl::RootContextPtr& context) {
+    auto state = ContextState::get(context);
+    auto events = emscripten::val::array();
+    if (!state)
+        return events;
+    auto& registry = state->getEvents();
+    registry.prune();
+
+    int index = 0;
+    while (context->hasEvent()) {
+        auto event = popEvent(context);
+        events.set(index++, EventMethods::decode(event, registry.retain(event), state->getComponents()));
+    }
+    return events;
+}
+
+void
+ContextMethods::resolveEvent(const apl::RootContextPtr& context, int token) {
+    auto state = ContextState::get(context);
+    if (!state)
+        return;
+    auto& registry = state->getEvents();
+    auto event = registry.get(token);
+    if (event) {
+        EventMethods::resolve(*event);
+        registry.release(token);
+    }
+}
+
+void
+ContextMethods::resolveEventWithArg(const apl::RootContextPtr& context, int token, int argument) {
+    auto state = ContextState::get(context);
+    if (!state)
+        return;
+    auto& registry = state->getEvents();
+    auto event = registry.get(token);
+    if (event) {
+        EventMethods::resolveWithArg(*event, argument);
+        registry.release(token);
+    }
+}
+
+void
+ContextMethods::resolveEventWithRect(const apl::RootContextPtr& context, int token, int x, int y, int width, int height) {
+    auto state = ContextState::get(context);
+    if (!state)
+        return;
+    auto& registry = state->getEvents();
+    auto event = registry.get(token);
+    if (event) {
+        EventMethods::resolveWithRect(*event, x, y, width, height);
+        registry.release(token);
+    }
+}
+
+void
+ContextMethods::addEventTerminateCallback(const apl::RootContextPtr& context, int token, emscripten::val callback) {
+    auto state = ContextState::get(context);
+    auto event = state ? state->getEvents().get(token) : nullptr;
+    if (event)
+        EventMethods::addTerminateCallback(*event, callback);
+}
+
 bool
 ContextMethods::screenLock(const apl::RootContextPtr& context) {
     return context->screenLock();
@@ -356,6 +683,107 @@ ContextMethods::setLocalTimeAdjustment(const apl::RootContextPtr& context, apl::
     context->setLocalTimeAdjustment(offset);
 }
 
+/**
+ * Start one core frame. The order of operations matters to core and matches what the viewhost
+ * used to do with separate calls: drive audio players, move the clock forward, clear pending
+ * actions and drain events. The viewhost processes the returned events and then calls
+ * collectFrame, so properties dirtied while handling them land in this frame.
+ */
+emscripten::val
+ContextMethods::tick(const apl::RootContextPtr& context, apl_time_t currentTime, apl_time_t utcTime, apl_duration_t offset) {
+    auto frame = emscripten::val::object();
+    auto state = ContextState::get(context);
+    if (!state) {
+        // A late frame of a destroyed context
+        frame.set("eventCount", 0);
+        frame.set("decodedEvents", false);
+        frame.set("events", emscripten::val::array());
+        return frame;
+    }
+
+    auto audioPlayerFactory = std::dynamic_pointer_cast<AudioPlayerFactory>(context->getRootConfig().getAudioPlayerFactory());
+    if (audioPlayerFactory) {
+        audioPlayerFactory->tick();
+    }
+
+    context->updateTime(currentTime, utcTime);
+    context->setLocalTimeAdjustment(offset);
+    context->clearPending();
+
+    auto events = emscripten::val::array();
+    int eventCount = 0;
+    bool decodeEvents = state->getDecodeEvents();
+    if (decodeEvents) {
+        events = drainEvents(context);
+        eventCount = events["length"].as<int>();
+    } else {
+        while (context->hasEvent()) {
+            events.call<void>("push", popEvent(context));
+            eventCount++;
+        }
+    }
+    frame.set("eventCount", eventCount);
+    frame.set("decodedEvents", decodeEvents);
+    frame.set("events", events);
+    return frame;
+}
+
+/**
+ * Finish the core frame started by tick: collect the dirty properties, check screen lock and
+ * pending errors, and report whether the next frame has work to do.
+ *
+ * The frame delta holds views into wasm memory, so it is collected last: everything that may
+ * allocate on the wasm heap (and grow it, detaching the views) runs before it, and only clearing
+ * the dirty set and reading plain values follow.
+ */
+emscripten::val
+ContextMethods::collectFrame(const apl::RootContextPtr& context) {
+    auto m = context->getUserData<WASMMetrics>();
+    auto frame = emscripten::val::object();
+    auto state = ContextState::get(context);
+
+    // Dirty properties are left in place until the content is ready
+    auto content = context->content();
+    bool ready = !content || content->isReady();
+    frame.set("ready", ready);
+    frame.set("screenLock", context->screenLock());
+
+    auto errors = collectPendingErrors(context);
+    bool hasPendingErrors = !errors.empty();
+    frame.set("hasPendingErrors", hasPendingErrors);
+    frame.set("errors", hasPendingErrors ? emscripten::getValFromObject(errors, m) : emscripten::val::null());
+    auto released = state ? state->getComponents().collectReleased() : std::vector<int>();
+    frame.set("releasedHandles", released.empty() ? emscripten::val::null() : toInt32Array(released));
+
+    int dirtyCount = 0;
+    auto delta = emscripten::val::null();
+    if (state && ready && context->isDirty()) {
+        dirtyCount = context->getDirty().size();
+        delta = state->getFrameDelta().collect(context->getDirty(), m);
+        context->clearDirty();
+    }
+    frame.set("dirtyCount", dirtyCount);
+    frame.set("delta", delta);
+    frame.set("pendingWork", hasPendingWork(context));
+    frame.set("nextTime", context->nextTime());
+    return frame;
+}
+
+bool
+ContextMethods::hasPendingWork(const apl::RootContextPtr& context) {
+    if (context->isDirty() || context->hasEvent())
+        return true;
+
+    // Dirty properties are held back until the content is ready, keep polling until then
+    auto content = context->content();
+    if (content && !content->isReady())
+        return true;
+
+    // Audio players report their playback position on every tick
+    auto audioPlayerFactory = std::dynamic_pointer_cast<AudioPlayerFactory>(context->getRootConfig().getAudioPlayerFactory());
+    return audioPlayerFactory && audioPlayerFactory->isActive();
+}
+
 emscripten::val
 ContextMethods::getViewportPixelSize(const apl::RootContextPtr& context) {
     auto m = context->getUserData<WASMMetrics>();
@@ -381,7 +809,7 @@ ContextMethods::getViewportHeight(const apl::RootContextPtr& context) {
 double
 ContextMethods::getScaleFactor(const apl::RootContextPtr& context) {
     auto m = context->getUserData<WASMMetrics>();
-    return m->toViewhost(1.0f);
+    return m->getViewhostScale();
 }
 
 void
@@ -404,6 +832,51 @@ ContextMethods::handlePointerEvent(const apl::RootContextPtr& context,
     return context->handlePointerEvent(pointerEvent);
 }
 
+emscripten::val
+ContextMethods::handlePointerEvents(const apl::RootContextPtr& context, emscripten::val events) {
+    auto m = context->getUserData<WASMMetrics>();
+    auto scale = m->getCoreScale();
+    auto packed = emscripten::convertJSArrayToNumberVector<double>(events);
+    auto count = packed.size() / POINTER_EVENT_SIZE;
+
+    // A move is superseded by a later move of the same pointer, unless another event of that
+    // pointer comes in between. Walk backwards so each move knows what follows it.
+    std::vector<int> target(count);
+    std::map<int, int> nextMove;
+    for (size_t i = count; i-- > 0;) {
+        const auto* event = &packed[i * POINTER_EVENT_SIZE];
+        auto type = static_cast<apl::PointerEventType>(event[0]);
+        auto pointerId = static_cast<int>(event[3]);
+        target[i] = i;
+        if (type == apl::PointerEventType::kPointerMove) {
+            auto it = nextMove.find(pointerId);
+            if (it != nextMove.end() && it->second >= 0)
+                target[i] = it->second;
+            else
+                nextMove[pointerId] = i;
+        } else {
+            nextMove[pointerId] = -1;
+        }
+    }
+
+    std::vector<uint8_t> consumed(count, 0);
+    for (size_t i = 0; i < count; i++) {
+        if (target[i] != static_cast<int>(i))
+            continue;
+        const auto* event = &packed[i * POINTER_EVENT_SIZE];
+        apl::Point cursorPosition(event[1] * scale, event[2] * scale);
+        apl::PointerEvent pointerEvent(static_cast<apl::PointerEventType>(event[0]), cursorPosition,
+                                       static_cast<apl::id_type>(event[3]), static_cast<apl::PointerType>(event[4]));
+        consumed[i] = context->handlePointerEvent(pointerEvent) ? 1 : 0;
+    }
+
+    // Coalesced moves report the result of the move that replaced them
+    for (size_t i = 0; i < count; i++)
+        consumed[i] = consumed[target[i]];
+
+    return emscripten::val::global("Uint8Array").new_(emscripten::typed_memory_view(consumed.size(), consumed.data()));
+}
+
 bool
 ContextMethods::handleKeyboard(const apl::RootContextPtr& context, int type, const emscripten::val& keyboard) {
     if (!keyboard.hasOwnProperty("code") || !keyboard.hasOwnProperty("key") || !keyboard.hasOwnProperty("repeat") ||
@@ -422,16 +895,53 @@ ContextMethods::handleKeyboard(const apl::RootContextPtr& context, int type, con
     return context->handleKeyboard(static_cast<apl::KeyHandlerType>(type), kbd);
 }
 
+bool
+ContextMethods::handleKeyboardCode(const apl::RootContextPtr& context, int type, int codeId, int keyId, int modifiers) {
+    return context->handleKeyboard(static_cast<apl::KeyHandlerType>(type), KeyTable::keyboard(codeId, keyId, modifiers));
+}
+
+emscripten::val
+ContextMethods::handleKeyboardSequence(const apl::RootContextPtr& context, emscripten::val events) {
+    auto packed = emscripten::convertJSArrayToNumberVector<int>(events);
+    auto count = packed.size() / KEYBOARD_EVENT_SIZE;
+    std::vector<uint8_t> consumed(count, 0);
+    for (size_t i = 0; i < count; i++) {
+        const auto* event = &packed[i * KEYBOARD_EVENT_SIZE];
+        consumed[i] = handleKeyboardCode(context, event[0], event[1], event[2], event[3]) ? 1 : 0;
+    }
+    return emscripten::val::global("Uint8Array").new_(emscripten::typed_memory_view(consumed.size(), consumed.data()));
+}
+
 bool
 ContextMethods::processDataSourceUpdate(const apl::RootContextPtr& context, const std::string& payload, const std::string& type) {
-    if (std::find(KNOWN_DATA_SOURCES.begin(), KNOWN_DATA_SOURCES.end(), type) == KNOWN_DATA_SOURCES.end())
-        return false;
+    return applyDataSourceUpdate(context, type, payload);
+}
 
-    auto provider = std::static_pointer_cast<DynamicIndexListDataSourceProvider>(context->getRootConfig().getDataSourceProvider(type));
-    if (!provider)
-        return false;
+emscripten::val
+ContextMethods::processDataSourceUpdates(const apl::RootContextPtr& context, emscripten::val updates) {
+    auto count = updates.isArray() ? updates["length"].as<size_t>() : 0;
+    std::vector<uint8_t> processed(count, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        auto entry = updates[i];
+        // Malformed entries are reported as not processed instead of throwing out of the batch
+        if (entry.isNull() || entry.typeOf().as<std::string>() != "object" ||
+            !entry["payload"].isString()) {
+            LOG(LogLevel::WARN) << "Skipping data source update " << i << " without a string payload";
+            continue;
+        }
+        auto type = entry["type"].isString() ? entry["type"].as<std::string>() : DYNAMIC_INDEX_LIST;
+        processed[i] = applyDataSourceUpdate(context, type, entry["payload"].as<std::string>()) ? 1 : 0;
+    }
+    return emscripten::val::global("Uint8Array").new_(emscripten::typed_memory_view(processed.size(), processed.data()));
+}
 
-    return provider->processUpdate(payload);
+emscripten::val
+ContextMethods::adjustFetchRequest(const apl::RootContextPtr& context, const std::string& type, emscripten::val payload) {
+    auto state = ContextState::get(context);
+    if (type != DYNAMIC_INDEX_LIST || !state)
+        return payload;
+    return state->getFetchWindow().adjust(payload);
 }
 
 void
@@ -442,10 +952,15 @@ ContextMethods::handleDisplayMetrics(const apl::RootContextPtr& context, emscrip
 void
 ContextMethods::configurationChange(const apl::RootContextPtr& context, emscripten::val configurationChange, emscripten::val metrics, emscripten::val scalingOptions) {
     auto configChange = *(configurationChange.as<std::shared_ptr<ConfigurationChange>>());
+    // Font scale, theme and other environment changes can all affect text measurement
+    auto textMeasure = getTextMeasurement(context);
+    if (textMeasure) {
+        textMeasure->getCache().clear();
+    }
+
     if (metrics.isUndefined()) {
         context->configurationChange(configChange);
     } else {
-        auto m = context->getUserData<WASMMetrics>();
         auto coreMetrics = *(metrics.as<std::shared_ptr<Metrics>>());
 
         std::vector<ViewportSpecification> specs;
@@ -460,18 +975,65 @@ ContextMethods::configurationChange(const apl::RootContextPtr& context, emscript
             k
         );
 
+        // Components, events and graphics hold the metrics pointer, so the context metrics are
+        // updated in place rather than replaced
+        auto state = ContextState::get(context);
+        if (!state)
+            return;
         if (!scalingOptions.isUndefined()) {
             ScalingOptions so(specs, k, shapeOverridesCost);
-            m = new WASMMetrics(coreMetrics, so);
+            state->updateMetrics(WASMMetrics(coreMetrics, so));
         }
         else {
-            m = new WASMMetrics(coreMetrics);
+            state->updateMetrics(WASMMetrics(coreMetrics));
         }
+        auto m = state->getMetrics();
         float newWidth = m->toViewhost(coreMetrics.getWidth());
         float newHeight = m->toViewhost(coreMetrics.getHeight());
         configChange.size((int) m->toCorePixel(newWidth), (int) m->toCorePixel(newHeight));
+        if (textMeasure) {
+            textMeasure->setMetrics(m);
+        }
         context->configurationChange(configChange);
-        context->setUserData(m);
+    }
+}
+
+std::shared_ptr<WasmTextMeasurement>
+ContextMethods::getTextMeasurement(const apl::RootContextPtr& context) {
+    auto state = ContextState::get(context);
+    return state ? state->getTextMeasurement() : nullptr;
+}
+
+emscripten::val
+ContextMethods::getTextMeasurementCacheStats(const apl::RootContextPtr& context) {
+    auto stats = emscripten::val::object();
+    auto textMeasure = getTextMeasurement(context);
+    if (!textMeasure)
+        return stats;
+
+    const auto& cache = textMeasure->getCache();
+    stats.set("hits", cache.getHits());
+    stats.set("misses", cache.getMisses());
+    stats.set("evictions", cache.getEvictions());
+    stats.set("entries", cache.getEntryCount());
+    stats.set("bytes", cache.getBytes());
+    stats.set("byteBudget", cache.getByteBudget());
+    return stats;
+}
+
+void
+ContextMethods::setTextMeasurementCacheBudget(const apl::RootContextPtr& context, double byteBudget) {
+    auto textMeasure = getTextMeasurement(context);
+    if (textMeasure) {
+        textMeasure->getCache().setByteBudget(toByteBudget(byteBudget));
+    }
+}
+
+void
+ContextMethods::clearTextMeasurementCache(const apl::RootContextPtr& context) {
+    auto textMeasure = getTextMeasurement(context);
+    if (textMeasure) {
+        textMeasure->getCache().clear();
     }
 }
 
@@ -523,39 +1085,71 @@ EMSCRIPTEN_BINDINGS(apl_wasm_context) {
 
     emscripten::class_<apl::RootContext>("Context")
         .smart_ptr<apl::RootContextPtr>("ContextPtr")
+        .function("destroy", &internal::ContextMethods::destroy)
         .function("topComponent", &internal::ContextMethods::topComponent)
         .function("topDocument", &internal::ContextMethods::topDocument)
+        .function("getComponentHandle", &internal::ContextMethods::getComponentHandle)
+        .function("getTopComponentHandle", &internal::ContextMethods::getTopComponentHandle)
+        .function("getComponentByHandle", &internal::ContextMethods::getComponentByHandle)
+        .function("getParentHandle", &internal::ContextMethods::getParentHandle)
+        .function("getChildHandles", &internal::ContextMethods::getChildHandles)
+        .function("getDisplayedChildHandles", &internal::ContextMethods::getDisplayedChildHandles)
+        .function("getComponentTypes", &internal::ContextMethods::getComponentTypes)
+        .function("getGlobalBoundsForHandles", &internal::ContextMethods::getGlobalBoundsForHandles)
+        .function("getCalculatedForHandles", &internal::ContextMethods::getCalculatedForHandles)
+        .function("collectReleasedHandles", &internal::ContextMethods::collectReleasedHandles)
         .function("getBackground", &internal::ContextMethods::getBackground)
         .function("setBackground", &internal::ContextMethods::setBackground)
         .function("getDocumentState", &internal::ContextMethods::getDocumentState)
         .function("getDataSourceContext", &internal::ContextMethods::getDataSourceContext)
         .function("getVisualContext", &internal::ContextMethods::getVisualContext)
+        .function("getDocumentStateAs", &internal::ContextMethods::getDocumentStateAs)
+        .function("getDataSourceContextAs", &internal::ContextMethods::getDataSourceContextAs)
+        .function("getVisualContextAs", &internal::ContextMethods::getVisualContextAs)
         .function("clearPending", &internal::ContextMethods::clearPending)
         .function("isDirty", &internal::ContextMethods::isDirty)
         .function("clearDirty", &internal::ContextMethods::clearDirty)
         .function("getDirty", &internal::ContextMethods::getDirty)
+        .function("collectFrameDelta", &internal::ContextMethods::collectFrameDelta)
         .function("getPendingErrors", &internal::ContextMethods::getPendingErrors)
         .function("hasEvent", &internal::ContextMethods::hasEvent)
         .function("popEvent", &internal::ContextMethods::popEvent)
+        .function("drainEvents", &internal::ContextMethods::drainEvents)
+        .function("resolveEvent", &internal::ContextMethods::resolveEvent)
+        .function("resolveEventWithArg", &internal::ContextMethods::resolveEventWithArg)
+        .function("resolveEventWithRect", &internal::ContextMethods::resolveEventWithRect)
+        .function("addEventTerminateCallback", &internal::ContextMethods::addEventTerminateCallback)
         .function("screenLock", &internal::ContextMethods::screenLock)
         .function("scrollToRectInComponent", &internal::ContextMethods::scrollToRectInComponent)
         .function("executeCommands", &internal::ContextMethods::executeCommands)
+        .function("executeCommandTemplate", &internal::ContextMethods::executeCommandTemplate)
         .function("invokeExtensionEventHandler", &internal::ContextMethods::invokeExtensionEventHandler)
         .function("cancelExecution", &internal::ContextMethods::cancelExecution)
         .function("currentTime", &internal::ContextMethods::currentTime)
         .function("nextTime", &internal::ContextMethods::nextTime)
         .function("updateTime", &internal::ContextMethods::updateTime)
         .function("setLocalTimeAdjustment", &internal::ContextMethods::setLocalTimeAdjustment)
+        .function("tick", &internal::ContextMethods::tick)
+        .function("collectFrame", &internal::ContextMethods::collectFrame)
+        .function("hasPendingWork", &internal::ContextMethods::hasPendingWork)
         .function("getViewportPixelSize", &internal::ContextMethods::getViewportPixelSize)
         .function("getViewportWidth", &internal::ContextMethods::getViewportWidth)
         .function("getViewportHeight", &internal::ContextMethods::getViewportHeight)
         .function("getScaleFactor", &internal::ContextMethods::getScaleFactor)
         .function("updateCursorPosition", &internal::ContextMethods::updateCursorPosition)
         .function("handlePointerEvent", &internal::ContextMethods::handlePointerEvent)
+        .function("handlePointerEvents", &internal::ContextMethods::handlePointerEvents)
         .function("handleKeyboard", &internal::ContextMethods::handleKeyboard)
+        .function("handleKeyboardCode", &internal::ContextMethods::handleKeyboardCode)
+        .function("handleKeyboardSequence", &internal::ContextMethods::handleKeyboardSequence)
         .function("processDataSourceUpdate", &internal::ContextMethods::processDataSourceUpdate)
+        .function("processDataSourceUpdates", &internal::ContextMethods::processDataSourceUpdates)
+        .function("adjustFetchRequest", &internal::ContextMethods::adjustFetchRequest)
         .function("handleDisplayMetrics", &internal::ContextMethods::handleDisplayMetrics)
         .function("configurationChange", &internal::ContextMethods::configurationChange)
+        .function("getTextMeasurementCacheStats", &internal::ContextMethods::getTextMeasurementCacheStats)
+        .function("setTextMeasurementCacheBudget", &internal::ContextMethods::setTextMeasurementCacheBudget)
+        .function("clearTextMeasurementCache", &internal::ContextMethods::clearTextMeasurementCache)
         .function("updateDisplayState", &internal::ContextMethods::updateDisplayState)
         .function("reInflate", &internal::ContextMethods::reInflate)
         .function("setFocus", &internal::ContextMethods::setFocus)
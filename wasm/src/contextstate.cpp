@@ -0,0 +1,140 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/contextstate.h"
+#include "wasm/textmeasurement.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+using ContextStateMap = std::unordered_map<const RootContext*, std::unique_ptr<ContextState>>;
+struct Retired {
+    std::weak_ptr<RootContext> context;
+    std::vector<std::weak_ptr<Context>> trees;
+    std::unique_ptr<WASMMetrics> metrics;
+
+    bool expired() const {
+        if (!context.expired())
+            return false;
+        return std::all_of(trees.begin(), trees.end(),
+                           [](const std::weak_ptr<Context>& tree) { return tree.expired(); });
+    }
+};
+
+using RetiredMetrics = std::vector<Retired>;
+
+ContextStateMap&
+contextStates() {
+    static ContextStateMap states;
+    return states;
+}
+
+// Metrics of released states, still the user data of core objects until their context is gone
+RetiredMetrics&
+retiredMetrics() {
+    static RetiredMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
+ContextState&
+ContextState::create(const RootContextPtr& context,
+                     std::unique_ptr<WASMMetrics> metrics,
+                     const std::shared_ptr<WasmTextMeasurement>& textMeasurement) {
+    // A new root context may reuse the address of a destroyed one, so drop stale states first
+    releaseExpired();
+
+    auto state = std::unique_ptr<ContextState>(new ContextState());
+    state->mContext = context;
+    state->mMetrics = std::move(metrics);
+    state->mTextMeasurement = textMeasurement;
+    state->mComponents.reset(new ComponentRegistry(state->mMetrics.get()));
+
+    auto& slot = contextStates()[context.get()];
+    slot = std::move(state);
+    return *slot;
+}
+
+ContextState*
+ContextState::get(const RootContextPtr& context) {
+    auto& states = contextStates();
+    auto it = states.find(context.get());
+    return it != states.end() ? it->second.get() : nullptr;
+}
+
+void
+ContextState::retainTree(const ComponentPtr& top) {
+    if (!top)
+        return;
+
+    // Every component of a tree holds a data context descending from the one of its top component
+    auto context = top->getContext();
+    mTrees.erase(std::remove_if(mTrees.begin(), mTrees.end(),
+                                [](const std::weak_ptr<Context>& tree) { return tree.expired(); }),
+                 mTrees.end());
+    for (const auto& tree : mTrees) {
+        if (tree.lock() == context)
+            return;
+    }
+    mTrees.emplace_back(context);
+}
+
+ContextState*
+ContextState::find(const WASMMetrics* metrics) {
+    for (auto& entry : contextStates()) {
+        if (entry.second->mMetrics.get() == metrics)
+            return entry.second.get();
+    }
+    return nullptr;
+}
+
+void
+ContextState::release(const RootContextPtr& context) {
+    auto& states = contextStates();
+    auto it = states.find(context.get());
+    if (it != states.end()) {
+        auto& state = *it->second;
+        state.retainTree(context->topComponent());
+
+        Retired retired;
+        retired.context = state.mContext;
+        retired.trees = std::move(state.mTrees);
+        retired.metrics = std::move(state.mMetrics);
+        retiredMetrics().emplace_back(std::move(retired));
+        states.erase(it);
+    }
+    releaseExpired();
+}
+
+void
+ContextState::releaseExpired() {
+    auto& states = contextStates();
+    auto& retired = retiredMetrics();
+    for (auto it = states.begin(); it != states.end();) {
+        if (it->second->mContext.expired()) {
+            // Components of the context may still be held by the viewhost
+            Retired entry;
+            entry.trees = std::move(it->second->mTrees);
+            entry.metrics = std::move(it->second->mMetrics);
+            retired.emplace_back(std::move(entry));
+            it = states.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [](const Retired& entry) { return entry.expired(); }),
+                  retired.end());
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,170 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/datasourcestream.h"
+#include "wasm/contentdata.h"
+#include "apl/utils/log.h"
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+// The stream decides where the data source ends, not the reader
+const unsigned PARSE_FLAGS = rapidjson::kParseStopWhenDoneFlag;
+
+bool
+isStructural(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':';
+}
+
+bool
+isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+} // namespace
+
+/**
+ * Reader input over the pending bytes. Offsets are those of the whole data source.
+ */
+struct DataSourceStream::ChunkStream {
+    typedef char Ch;
+
+    ChunkStream(const char* data, size_t size, size_t base)
+        : mBegin(data), mCurrent(data), mEnd(data + size), mBase(base) {}
+
+    Ch Peek() const { return mCurrent < mEnd ? *mCurrent : '\0'; }
+    Ch Take() { return mCurrent < mEnd ? *mCurrent++ : '\0'; }
+    size_t Tell() const { return mBase + (mCurrent - mBegin); }
+
+    Ch* PutBegin() { RAPIDJSON_ASSERT(false); return nullptr; }
+    void Put(Ch) { RAPIDJSON_ASSERT(false); }
+    void Flush() { RAPIDJSON_ASSERT(false); }
+    size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+
+    const char* mBegin;
+    const char* mCurrent;
+    const char* mEnd;
+    size_t mBase;
+};
+
+DataSourceStreamPtr
+DataSourceStream::create(const apl::ContentPtr& content, const std::string& name) {
+    return std::make_shared<DataSourceStream>(content, name);
+}
+
+DataSourceStream::DataSourceStream(const apl::ContentPtr& content, const std::string& name)
+    : mContent(content),
+      mName(name),
+      mDocument(std::make_shared<rapidjson::Document>())
+{
+    mReader.IterativeParseInit();
+}
+
+bool
+DataSourceStream::write(emscripten::val chunk) {
+    if (mFailed || mEnded)
+        return !mFailed;
+
+    auto length = chunk["length"].as<size_t>();
+    auto offset = mPending.size();
+    mPending.resize(offset + length);
+    auto view = emscripten::val(emscripten::typed_memory_view(length, reinterpret_cast<uint8_t*>(mPending.data() + offset)));
+    view.call<void>("set", chunk);
+
+    scan(offset);
+    return parse(false);
+}
+
+bool
+DataSourceStream::end() {
+    if (mEnded)
+        return false;
+    mEnded = true;
+
+    if (!mFailed && parse(true)) {
+        for (auto c : mPending) {
+            if (!isWhitespace(c)) {
+                LOG(LogLevel::ERROR) << "Unexpected data after data source " << mName;
+                mFailed = true;
+                break;
+            }
+        }
+    }
+
+    if (!mFailed && !mReader.IterativeParseComplete()) {
+        LOG(LogLevel::ERROR) << "Truncated data source " << mName;
+        mFailed = true;
+    }
+
+    mPending.clear();
+    mPending.shrink_to_fit();
+    if (mFailed)
+        return false;
+
+    // The document was the handler of the reader, move the root value out of its stack
+    auto finish = [](rapidjson::Document&) { return true; };
+    mDocument->Populate(finish);
+    ContentData::add(mContent, mName, mDocument);
+    return true;
+}
+
+void
+DataSourceStream::scan(size_t from) {
+    for (size_t i = from; i < mPending.size(); i++) {
+        auto c = mPending[i];
+        if (mInString) {
+            if (mEscape)
+                mEscape = false;
+            else if (c == '\\')
+                mEscape = true;
+            else if (c == '"')
+                mInString = false;
+        } else if (c == '"') {
+            mInString = true;
+        } else if (isStructural(c)) {
+            mStructural[0] = mStructural[1];
+            mStructural[1] = mBase + i;
+            mStructuralCount++;
+        }
+    }
+}
+
+bool
+DataSourceStream::parse(bool all) {
+    // A step of the reader reads a token and, after a delimiter, the token that follows it. Both
+    // are complete when the step starts at or before the second to last structural character.
+    if (!all && mStructuralCount < 2)
+        return true;
+
+    ChunkStream stream(mPending.data(), mPending.size(), mBase);
+    while (!mReader.IterativeParseComplete() && (all || stream.Tell() <= mStructural[0])) {
+        if (!mReader.IterativeParseNext<PARSE_FLAGS>(stream, *mDocument)) {
+            LOG(LogLevel::ERROR) << "Data source " << mName << " parse error at offset "
+                                 << mReader.GetErrorOffset();
+            mFailed = true;
+            return false;
+        }
+    }
+
+    auto consumed = stream.mCurrent - stream.mBegin;
+    mPending.erase(mPending.begin(), mPending.begin() + consumed);
+    mBase += consumed;
+    return true;
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_data_source_stream) {
+    emscripten::class_<DataSourceStream>("DataSourceStream")
+        .smart_ptr<DataSourceStreamPtr>("DataSourceStreamPtr")
+        .class_function("create", &DataSourceStream::create)
+        .function("write", &DataSourceStream::write)
+        .function("end", &DataSourceStream::end)
+        .function("getParsedBytes", &DataSourceStream::getParsedBytes)
+        .function("hasError", &DataSourceStream::hasError);
+}
+
+} // namespace wasm
+} // namespace apl
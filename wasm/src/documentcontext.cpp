@@ -4,6 +4,9 @@
  */
 
 #include "wasm/documentcontext.h"
+#include "wasm/commandcache.h"
+#include "wasm/jsonbridge.h"
+#include "wasm/visualcontextreporter.h"
 
 #include "apl/apl.h"
 #include "apl/dynamicdata.h"
@@ -17,13 +20,14 @@ namespace wasm {
 namespace internal {
 
 
+// Through the generations of VisualContextReporter, which shares the dirty flag of core
 bool
 DocumentContextMethods::isVisualContextDirty(const apl::DocumentContextPtr& context) {
-    return context->isVisualContextDirty();
+    return VisualContextReporter::isDirty(context);
 }
 void
 DocumentContextMethods::clearVisualContextDirty(const apl::DocumentContextPtr& context) {
-    return context->clearVisualContextDirty();
+    VisualContextReporter::clearDirty(context);
 }
 
 std::string
@@ -37,6 +41,12 @@ DocumentContextMethods::getVisualContext(const apl::DocumentContextPtr& context)
     return buffer.GetString();
 }
 
+emscripten::val
+DocumentContextMethods::getVisualContextAs(const apl::DocumentContextPtr& context, int mode) {
+    rapidjson::Document state(rapidjson::kObjectType);
+    return JsonBridge::convert(context->serializeVisualContext(state.GetAllocator()), mode);
+}
+
 bool
 DocumentContextMethods::isDataSourceContextDirty(const apl::DocumentContextPtr& context) {
     return context->isDataSourceContextDirty();
@@ -58,27 +68,28 @@ DocumentContextMethods::getDataSourceContext(const apl::DocumentContextPtr& cont
     return buffer.GetString();
 }
 
+emscripten::val
+DocumentContextMethods::getDataSourceContextAs(const apl::DocumentContextPtr& context, int mode) {
+    rapidjson::Document state(rapidjson::kObjectType);
+    return JsonBridge::convert(context->serializeDataSourceContext(state.GetAllocator()), mode);
+}
+
 apl::ActionPtr
 DocumentContextMethods::executeCommands(const apl::DocumentContextPtr& context, const std::string& commands, bool fastMode) {
-    auto* doc = new rapidjson::Document();
-    doc->Parse(commands.c_str());
-    apl::Object obj = apl::Object(*doc);
-    auto action = context->executeCommands(obj, fastMode);
-    action->setUserData(doc);
-    // The consumer is not required to add a "then" or "terminate" callback,
-    // so add them here to clean up the document
-    action->then([doc](const ActionPtr& action) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
-    action->addTerminateCallback([doc, action](const std::shared_ptr<Timers>&) {
-        if (action->getUserData() != nullptr) {
-            delete doc;
-            action->setUserData(nullptr);
-        }
-    });
+    auto document = CommandCache::get(commands);
+    auto action = context->executeCommands(apl::Object(document->value()), fastMode);
+    CommandCache::retain(action, document);
+    return action;
+}
+
+apl::ActionPtr
+DocumentContextMethods::executeCommandTemplate(const apl::DocumentContextPtr& context, const std::string& name,
+                                               emscripten::val arguments, bool fastMode) {
+    auto document = CommandCache::instantiate(name, arguments);
+    if (!document)
+        return nullptr;
+    auto action = context->executeCommands(apl::Object(document->value()), fastMode);
+    CommandCache::retain(action, document);
     return action;
 }
 
@@ -90,10 +101,13 @@ EMSCRIPTEN_BINDINGS(apl_wasm_document_context) {
         .function("isVisualContextDirty", &internal::DocumentContextMethods::isVisualContextDirty)
         .function("clearVisualContextDirty", &internal::DocumentContextMethods::clearVisualContextDirty)
         .function("getVisualContext", &internal::DocumentContextMethods::getVisualContext)
+        .function("getVisualContextAs", &internal::DocumentContextMethods::getVisualContextAs)
         .function("isDataSourceContextDirty", &internal::DocumentContextMethods::isDataSourceContextDirty)
         .function("clearDataSourceContextDirty", &internal::DocumentContextMethods::clearDataSourceContextDirty)
         .function("getDataSourceContext", &internal::DocumentContextMethods::getDataSourceContext)
-        .function("executeCommands", &internal::DocumentContextMethods::executeCommands);
+        .function("getDataSourceContextAs", &internal::DocumentContextMethods::getDataSourceContextAs)
+        .function("executeCommands", &internal::DocumentContextMethods::executeCommands)
+        .function("executeCommandTemplate", &internal::DocumentContextMethods::executeCommandTemplate);
 }
 
 }
@@ -6,13 +6,14 @@
 #include "wasm/embindutils.h"
 #include "apl/apl.h"
 #include "wasm/rect.h"
+#include <limits>
 
 namespace emscripten {
 
 void
 iterateProps(const apl::CalculatedPropertyMap& calculated, emscripten::val& map, WASMMetrics* m) {
     for (const auto& e : calculated) {
-        auto prop = getValFromObject(e.second, m);
+        auto prop = getValFromProperty(e.first, e.second, m);
         if (!prop.isUndefined()) {
             map.set(static_cast<int>(e.first), prop);
         }
@@ -21,58 +22,70 @@ iterateProps(const apl::CalculatedPropertyMap& calculated, emscripten::val& map,
 
 emscripten::val
 getValFromObject(const apl::Object& prop, WASMMetrics* m) {
-    if (prop.isNumber())
-        return emscripten::val(prop.getDouble());
-    else if (prop.isBoolean())
-        return emscripten::val(prop.getBoolean());
-    else if (prop.isString())
-        return emscripten::val(prop.getString());
-    else if (prop.is<apl::Color>())
-        return emscripten::val(prop.getColor());
-    else if (prop.isAbsoluteDimension()) {
-        auto scale = m->toViewhost(1.0f);
-        return emscripten::val(prop.getAbsoluteDimension() * scale);
-    }
-    else if (prop.is<apl::Filter>())
-        return getValFromObject(prop.get<apl::Filter>(), m);
-    else if (prop.is<apl::Radii>())
-        return getValFromObject(prop.get<apl::Radii>(), m);
-    else if (prop.is<apl::Rect>())
-        return getValFromObject(prop.get<apl::Rect>(), m);
-    else if (prop.is<apl::Gradient>())
-        return getValFromObject(prop.get<apl::Gradient>(), m);
-    else if (prop.is<apl::GraphicFilter>())
-        return getValFromObject(prop.get<apl::GraphicFilter>(), m);
-    else if (prop.is<apl::GraphicPattern>())
-        return emscripten::val(prop.get<apl::GraphicPattern>());
-    else if (prop.is<apl::MediaSource>())
-        return getValFromObject(prop.get<apl::MediaSource>(), m);
-    else if (prop.isMap())
-        return getValFromObject(prop.getMap(), m);
-    else if (prop.isArray())
-        return getValFromObject(prop.getArray(), m);
-    else if (prop.is<apl::StyledText>())
-        return getValFromObject(prop.get<apl::StyledText>(), m);
-    else if (prop.is<apl::Graphic>()) {
-        // set the metrics here because we need them for scaling
-        // a graphic element, which is derived from a graphic.
-        auto graphic = prop.get<apl::Graphic>();
-        graphic->setUserData(m);
-        return emscripten::val(graphic);
-    }
-    else if (prop.is<apl::Transform2D>()) {
-        auto transform = prop.get<apl::Transform2D>().get();
-        auto mat = "matrix(" + std::to_string(transform[0]) + "," +
-                    std::to_string(transform[1]) + "," + std::to_string(transform[2]) + "," +
-                    std::to_string(transform[3]) + "," + std::to_string(transform[4]) +
-                    "," + std::to_string(transform[5]) + ")";
-        return emscripten::val(mat);
+    return getValFromObject(prop, apl::wasm::PropertyConversion::classify(prop), m);
+}
+
+emscripten::val
+getValFromProperty(apl::PropertyKey key, const apl::Object& prop, WASMMetrics* m) {
+    return getValFromObject(prop, apl::wasm::PropertyConversion::lookup(key, prop), m);
+}
+
+emscripten::val
+getValFromObject(const apl::Object& prop, apl::wasm::ConversionKind kind, WASMMetrics* m) {
+    switch (kind) {
+        case apl::wasm::kConversionNumber:
+            return emscripten::val(prop.getDouble());
+        case apl::wasm::kConversionBoolean:
+            return emscripten::val(prop.getBoolean());
+        case apl::wasm::kConversionString:
+            return emscripten::val(prop.getString());
+        case apl::wasm::kConversionColor:
+            return emscripten::val(prop.getColor());
+        case apl::wasm::kConversionAbsoluteDimension:
+            return emscripten::val(prop.getAbsoluteDimension() * m->getViewhostScale());
+        case apl::wasm::kConversionFilter:
+            return getValFromObject(prop.get<apl::Filter>(), m);
+        case apl::wasm::kConversionRadii:
+            return getValFromObject(prop.get<apl::Radii>(), m);
+        case apl::wasm::kConversionRect:
+            return getValFromObject(prop.get<apl::Rect>(), m);
+        case apl::wasm::kConversionGradient:
+            return getValFromObject(prop.get<apl::Gradient>(), m);
+        case apl::wasm::kConversionGraphicFilter:
+            return getValFromObject(prop.get<apl::GraphicFilter>(), m);
+        case apl::wasm::kConversionGraphicPattern:
+            return emscripten::val(prop.get<apl::GraphicPattern>());
+        case apl::wasm::kConversionMediaSource:
+            return getValFromObject(prop.get<apl::MediaSource>(), m);
+        case apl::wasm::kConversionMap:
+            return getValFromObject(prop.getMap(), m);
+        case apl::wasm::kConversionArray:
+            return getValFromObject(prop.getArray(), m);
+        case apl::wasm::kConversionStyledText:
+            return getValFromObject(prop.get<apl::StyledText>(), m);
+        case apl::wasm::kConversionGraphic: {
+            // set the metrics here because we need them for scaling
+            // a graphic element, which is derived from a graphic.
+            auto graphic = prop.get<apl::Graphic>();
+            graphic->setUserData(m);
+            return emscripten::val(graphic);
+        }
+        case apl::wasm::kConversionTransform2D:
+            return emscripten::val(getTransformString(prop.get<apl::Transform2D>()));
+        case apl::wasm::kConversionURLRequest:
+            return getValFromObject(prop.get<apl::URLRequest>(), m);
+        default:
+            return emscripten::val::undefined();
     }
-    else if (prop.is<apl::URLRequest>())
-        return getValFromObject(prop.get<apl::URLRequest>(), m);
+}
 
-    return emscripten::val::undefined();
-    
+double
+getNumberFromProperty(const apl::Object& prop, WASMMetrics* m) {
+    if (prop.isNumber())
+        return prop.getDouble();
+    if (prop.isAbsoluteDimension())
+        return prop.getAbsoluteDimension() * m->getViewhostScale();
+    return std::numeric_limits<double>::quiet_NaN();
 }
 
 emscripten::val
@@ -279,28 +292,29 @@ getValFromObject(const apl::GraphicFilter& graphicFilter, WASMMetrics* m) {
 
 emscripten::val
 getValFromObject(const apl::Radii& radii, WASMMetrics* m) {
-    if (m) {
-        auto topLeft = m->toViewhost(radii.topLeft());
-        auto topRight = m->toViewhost(radii.topRight());
-        auto bottomLeft = m->toViewhost(radii.bottomLeft());
-        auto bottomRight = m->toViewhost(radii.bottomRight());
-        return emscripten::val(apl::Radii(topLeft, topRight, bottomLeft, bottomRight));
-    } else
+    if (m)
+        return emscripten::val(m->toViewhostRadii(radii));
+    else
         return emscripten::val(radii);
 }
 
 emscripten::val
 getValFromObject(const apl::Rect& rect, WASMMetrics* m) {
-    if (m) {
-        auto x = m->toViewhost(rect.getX());
-        auto y = m->toViewhost(rect.getY());
-        auto w = m->toViewhost(rect.getWidth());
-        auto h = m->toViewhost(rect.getHeight());
-        return emscripten::val(apl::Rect(x, y, w, h));
-    } else
+    if (m)
+        return emscripten::val(m->toViewhostRect(rect));
+    else
         return emscripten::val(rect);
 }
 
+std::string
+getTransformString(const apl::Transform2D& transform2D) {
+    auto transform = transform2D.get();
+    return "matrix(" + std::to_string(transform[0]) + "," +
+           std::to_string(transform[1]) + "," + std::to_string(transform[2]) + "," +
+           std::to_string(transform[3]) + "," + std::to_string(transform[4]) +
+           "," + std::to_string(transform[5]) + ")";
+}
+
 apl::Object
 getObjectFromVal(emscripten::val val) {
     if (val.isTrue() || val.isFalse()) {
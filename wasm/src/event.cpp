@@ -5,6 +5,7 @@
 
 #include "wasm/event.h"
 #include "apl/apl.h"
+#include "wasm/contextstate.h"
 #include "wasm/embindutils.h"
 
 namespace apl {
@@ -12,11 +13,44 @@ namespace wasm {
 
 namespace internal {
 
+namespace {
+
+// Properties core sets on the events it hands to the viewhost
+const EventProperty DECODED_PROPERTIES[] = {
+    kEventPropertyAlign,
+    kEventPropertyArguments,
+    kEventPropertyAudioTrack,
+    kEventPropertyCommand,
+    kEventPropertyComponents,
+    kEventPropertyDirection,
+    kEventPropertyExtension,
+    kEventPropertyExtensionURI,
+    kEventPropertyExtensionResourceId,
+    kEventPropertyHeaders,
+    kEventPropertyHighlightMode,
+    kEventPropertyMediaType,
+    kEventPropertyName,
+    kEventPropertyPosition,
+    kEventPropertyReason,
+    kEventPropertyRangeStart,
+    kEventPropertyRangeEnd,
+    kEventPropertySource,
+    kEventPropertyValue,
+};
+
+} // namespace
+
 apl::ComponentPtr
 EventMethods::getComponent(const apl::Event& event) {
     return event.getComponent();
 }
 
+int
+EventMethods::getComponentHandle(const apl::Event& event) {
+    auto state = ContextState::find(event.getUserData<WASMMetrics>());
+    return state ? state->getComponents().handleFor(event.getComponent()) : ComponentRegistry::INVALID_HANDLE;
+}
+
 void
 EventMethods::resolve(const apl::Event& event) {
     event.getActionRef().resolve();
@@ -30,7 +64,7 @@ EventMethods::resolveWithArg(const apl::Event& event, int argument) {
 void
 EventMethods::resolveWithRect(const apl::Event& event, int x, int y, int width, int height) {
     auto m = event.getUserData<WASMMetrics>();
-    auto scale = m->toCore(1.0f);
+    auto scale = m->getCoreScale();
     Rect rect(x * scale, y * scale, width * scale, height * scale);
     event.getActionRef().resolve(rect);
 }
@@ -68,6 +102,24 @@ EventMethods::getValue(const apl::Event& event, int key) {
     return emscripten::getValFromObject(value, m);
 }
 
+emscripten::val
+EventMethods::decode(const apl::Event& event, int token, ComponentRegistry& components) {
+    auto m = event.getUserData<WASMMetrics>();
+    auto values = emscripten::val::object();
+    for (auto key : DECODED_PROPERTIES) {
+        auto value = event.getValue(key);
+        if (!value.isNull())
+            values.set(static_cast<int>(key), emscripten::getValFromObject(value, m));
+    }
+
+    auto decoded = emscripten::val::object();
+    decoded.set("type", static_cast<int>(event.getType()));
+    decoded.set("token", token);
+    decoded.set("componentHandle", components.handleFor(event.getComponent()));
+    decoded.set("values", values);
+    return decoded;
+}
+
 } // namespace internal
 
 EMSCRIPTEN_BINDINGS(apl_wasm_event) {
@@ -76,6 +128,7 @@ EMSCRIPTEN_BINDINGS(apl_wasm_event) {
         .function("getType", &internal::EventMethods::getType)
         .function("getValue", &internal::EventMethods::getValue)
         .function("getComponent", &internal::EventMethods::getComponent)
+        .function("getComponentHandle", &internal::EventMethods::getComponentHandle)
         .function("resolve", &internal::EventMethods::resolve)
         .function("resolveWithArg", &internal::EventMethods::resolveWithArg)
         .function("resolveWithRect", &internal::EventMethods::resolveWithRect)
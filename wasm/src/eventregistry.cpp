@@ -0,0 +1,43 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/eventregistry.h"
+
+namespace apl {
+namespace wasm {
+
+int
+EventRegistry::retain(const Event& event) {
+    if (event.getActionRef().isEmpty())
+        return INVALID_TOKEN;
+
+    int token = mNextToken++;
+    mEvents.emplace(token, event);
+    return token;
+}
+
+const Event*
+EventRegistry::get(int token) const {
+    auto it = mEvents.find(token);
+    return it != mEvents.end() ? &it->second : nullptr;
+}
+
+void
+EventRegistry::release(int token) {
+    mEvents.erase(token);
+}
+
+void
+EventRegistry::prune() {
+    for (auto it = mEvents.begin(); it != mEvents.end();) {
+        if (it->second.getActionRef().isPending())
+            ++it;
+        else
+            it = mEvents.erase(it);
+    }
+}
+
+} // namespace wasm
+} // namespace apl
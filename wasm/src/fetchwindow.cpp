@@ -0,0 +1,253 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/fetchwindow.h"
+#include "wasm/contentdata.h"
+#include <emscripten.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+// Weight of the latest sample in the velocity average
+const double VELOCITY_SMOOTHING = 0.5;
+
+const char DYNAMIC_INDEX_LIST[] = "dynamicIndexList";
+
+bool
+readIndex(const rapidjson::Value& value, const char* name, int& index) {
+    auto it = value.FindMember(name);
+    if (it == value.MemberEnd() || !it->value.IsInt())
+        return false;
+    index = it->value.GetInt();
+    return true;
+}
+
+} // namespace
+
+void
+FetchWindow::adoptBounds(const ContentPtr& content) {
+    // Data sources are parameters of their own, or members of the whole "payload" parameter
+    for (const auto& data : ContentData::get(content)) {
+        const auto& value = *data.second;
+        if (!value.IsObject() || adoptList(value))
+            continue;
+        for (const auto& member : value.GetObject())
+            adoptList(member.value);
+    }
+}
+
+bool
+FetchWindow::adoptList(const rapidjson::Value& value) {
+    if (!value.IsObject())
+        return false;
+
+    auto type = value.FindMember("type");
+    auto listId = value.FindMember("listId");
+    if (type == value.MemberEnd() || !type->value.IsString() ||
+        std::strcmp(type->value.GetString(), DYNAMIC_INDEX_LIST) != 0 ||
+        listId == value.MemberEnd() || !listId->value.IsString())
+        return false;
+
+    Bounds bounds = {INT_MIN, INT_MAX};
+    readIndex(value, "minimumInclusiveIndex", bounds.minimum);
+    readIndex(value, "maximumExclusiveIndex", bounds.maximum);
+    mBounds[listId->value.GetString()] = bounds;
+    return true;
+}
+
+void
+FetchWindow::observeScroll(const ComponentPtr& component, float position) {
+    if (!isEnabled())
+        return;
+
+    auto now = emscripten_get_now();
+    if (component.get() != mScroller || now - mLastTime > IDLE_TIME) {
+        mScroller = component.get();
+        mLastPosition = position;
+        mLastTime = now;
+        mVelocity = 0;
+        return;
+    }
+
+    auto elapsed = now - mLastTime;
+    if (elapsed <= 0)
+        return;
+
+    // Items per page from the children on screen, pages from the size of the viewport
+    auto bounds = component->getCalculated(kPropertyBounds).getRect();
+    auto vertical = component->getCalculated(kPropertyScrollDirection).asInt() != kScrollDirectionHorizontal;
+    auto extent = vertical ? bounds.getHeight() : bounds.getWidth();
+    auto displayed = std::max<size_t>(component->getDisplayedChildCount(), 1);
+    if (extent <= 0)
+        return;
+
+    auto itemsPerSecond = (position - mLastPosition) / extent * displayed * 1000 / elapsed;
+    mVelocity = VELOCITY_SMOOTHING * itemsPerSecond + (1 - VELOCITY_SMOOTHING) * mVelocity;
+    mLastPosition = position;
+    mLastTime = now;
+}
+
+int
+FetchWindow::getWindow(int count) const {
+    if (!isEnabled() || emscripten_get_now() - mLastTime > IDLE_TIME)
+        return count;
+
+    auto window = static_cast<int>(std::ceil(std::abs(mVelocity) * LOOKAHEAD));
+    return std::max(count, std::min(window, mMaxWindow));
+}
+
+emscripten::val
+FetchWindow::adjust(emscripten::val payload) {
+    if (!isEnabled() || !payload["listId"].isString() || !payload["startIndex"].isNumber() ||
+        !payload["count"].isNumber())
+        return payload;
+
+    auto now = emscripten_get_now();
+    expire(now);
+
+    auto listId = payload["listId"].as<std::string>();
+    auto token = payload["correlationToken"].isString() ? payload["correlationToken"].as<std::string>() : "";
+    auto start = payload["startIndex"].as<int>();
+    auto count = payload["count"].as<int>();
+    auto end = start + count;
+    auto& inFlight = mInFlight[listId];
+
+    // Requests resent by core keep their token, they are not covered by themselves. A covered
+    // request still goes out unchanged, core waits for the answer to its token.
+    for (const auto& request : inFlight) {
+        if (request.correlationToken != token && request.start <= start && end <= request.end)
+            return payload;
+    }
+
+    // Never cut what core asked for, even when the bounds lag behind the list
+    auto bounds = mBounds.find(listId);
+    int64_t minimum = bounds != mBounds.end() ? std::min(bounds->second.minimum, start) : INT_MIN;
+    int64_t maximum = bounds != mBounds.end() ? std::max(bounds->second.maximum, end) : INT_MAX;
+
+    auto window = getWindow(count);
+    if (window > count) {
+        if (mVelocity >= 0) {
+            end = static_cast<int>(std::min<int64_t>(static_cast<int64_t>(start) + window, maximum));
+            for (const auto& request : inFlight)
+                if (request.start >= start + count && request.start < end)
+                    end = request.start;
+        } else {
+            start = static_cast<int>(std::max<int64_t>(static_cast<int64_t>(end) - window, minimum));
+            for (const auto& request : inFlight)
+                if (request.end <= end - count && request.end > start)
+                    start = request.end;
+        }
+    }
+
+    inFlight.erase(std::remove_if(inFlight.begin(), inFlight.end(),
+                                  [&](const Request& request) { return request.correlationToken == token; }),
+                   inFlight.end());
+    inFlight.push_back({token, start, end, now});
+
+    auto result = emscripten::val::object();
+    auto keys = emscripten::val::global("Object").call<emscripten::val>("keys", payload);
+    auto length = keys["length"].as<int>();
+    for (int i = 0; i < length; i++)
+        result.set(keys[i], payload[keys[i]]);
+    result.set("startIndex", start);
+    result.set("count", end - start);
+    return result;
+}
+
+void
+FetchWindow::complete(const std::string& payload) {
+    rapidjson::Document update;
+    update.Parse(payload.c_str(), payload.size());
+    if (update.HasParseError() || !update.IsObject())
+        return;
+
+    auto listId = update.FindMember("listId");
+    if (listId == update.MemberEnd() || !listId->value.IsString())
+        return;
+
+    updateBounds(listId->value.GetString(), update);
+
+    auto token = update.FindMember("correlationToken");
+    if (mInFlight.empty() || token == update.MemberEnd() || !token->value.IsString())
+        return;
+
+    auto it = mInFlight.find(listId->value.GetString());
+    if (it == mInFlight.end())
+        return;
+
+    std::string correlationToken = token->value.GetString();
+    auto& inFlight = it->second;
+    inFlight.erase(std::remove_if(inFlight.begin(), inFlight.end(),
+                                  [&](const Request& request) { return request.correlationToken == correlationToken; }),
+                   inFlight.end());
+}
+
+void
+FetchWindow::updateBounds(const std::string& listId, const rapidjson::Value& update) {
+    int minimum;
+    int maximum;
+    auto hasMinimum = readIndex(update, "minimumInclusiveIndex", minimum);
+    auto hasMaximum = readIndex(update, "maximumExclusiveIndex", maximum);
+    if (hasMinimum || hasMaximum) {
+        auto& bounds = mBounds.emplace(listId, Bounds{INT_MIN, INT_MAX}).first->second;
+        if (hasMinimum)
+            bounds.minimum = minimum;
+        if (hasMaximum)
+            bounds.maximum = maximum;
+    }
+
+    // Inserted and deleted items move the end of a bounded list
+    auto it = mBounds.find(listId);
+    auto operations = update.FindMember("operations");
+    if (it == mBounds.end() || it->second.maximum == INT_MAX ||
+        operations == update.MemberEnd() || !operations->value.IsArray())
+        return;
+
+    auto& bounds = it->second;
+    for (const auto& operation : operations->value.GetArray()) {
+        if (!operation.IsObject())
+            continue;
+        auto type = operation.FindMember("type");
+        if (type == operation.MemberEnd() || !type->value.IsString())
+            continue;
+
+        std::string name = type->value.GetString();
+        int count;
+        if (name == "InsertItem") {
+            bounds.maximum++;
+        } else if (name == "InsertMultipleItems") {
+            auto items = operation.FindMember("items");
+            if (items != operation.MemberEnd() && items->value.IsArray())
+                bounds.maximum += static_cast<int>(items->value.Size());
+        } else if (name == "DeleteItem") {
+            bounds.maximum--;
+        } else if (name == "DeleteMultipleItems" && readIndex(operation, "count", count)) {
+            bounds.maximum -= count;
+        }
+    }
+}
+
+void
+FetchWindow::expire(double now) {
+    for (auto it = mInFlight.begin(); it != mInFlight.end();) {
+        auto& inFlight = it->second;
+        inFlight.erase(std::remove_if(inFlight.begin(), inFlight.end(),
+                                      [&](const Request& request) { return now - request.time > REQUEST_TIMEOUT; }),
+                       inFlight.end());
+        if (inFlight.empty())
+            it = mInFlight.erase(it);
+        else
+            ++it;
+    }
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,530 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/fontmetrics.h"
+#include "apl/utils/log.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+// Family used when none of the requested families is registered. Matches DEFAULT_FONT in rootconfig.cpp
+const char FALLBACK_FAMILY[] = "amazon-ember-display";
+
+const uint32_t TAG_TRUE_TYPE = 0x00010000;
+const uint32_t TAG_APPLE_TRUE_TYPE = 0x74727565; // 'true'
+const uint32_t TAG_OPEN_TYPE = 0x4F54544F;       // 'OTTO'
+const uint32_t TAG_HEAD = 0x68656164;
+const uint32_t TAG_HHEA = 0x68686561;
+const uint32_t TAG_HMTX = 0x686D7478;
+const uint32_t TAG_CMAP = 0x636D6170;
+const uint32_t TAG_KERN = 0x6B65726E;
+const uint32_t TAG_GPOS = 0x47504F53;
+
+const uint16_t LOOKUP_PAIR_POSITIONING = 2;
+const uint16_t LOOKUP_EXTENSION = 9;
+const uint16_t VALUE_X_ADVANCE = 0x0004;
+
+inline uint32_t
+pairKey(uint16_t left, uint16_t right) {
+    return (static_cast<uint32_t>(left) << 16) | right;
+}
+
+inline int
+valueRecordSize(uint16_t valueFormat) {
+    int size = 0;
+    for (; valueFormat; valueFormat >>= 1)
+        size += (valueFormat & 1) * 2;
+    return size;
+}
+
+/**
+ * Offset of the XAdvance field in a value record, or -1 if the record has none
+ */
+inline int
+xAdvanceOffset(uint16_t valueFormat) {
+    if (!(valueFormat & VALUE_X_ADVANCE))
+        return -1;
+    return valueRecordSize(valueFormat & (VALUE_X_ADVANCE - 1));
+}
+
+std::string
+normalizeFamily(const std::string& family) {
+    std::string result;
+    result.reserve(family.size());
+    for (auto c : family) {
+        if (c == '"' || c == '\'')
+            continue;
+        result.push_back(std::tolower(static_cast<unsigned char>(c)));
+    }
+    auto begin = result.find_first_not_of(' ');
+    auto end = result.find_last_not_of(' ');
+    return begin == std::string::npos ? std::string() : result.substr(begin, end - begin + 1);
+}
+
+struct FontFace {
+    int weight;
+    bool italic;
+    FontMetricsPtr metrics;
+};
+
+std::map<std::string, std::vector<FontFace>>&
+registeredFonts() {
+    static std::map<std::string, std::vector<FontFace>> fonts;
+    return fonts;
+}
+
+FontMetricsPtr
+closestFace(const std::vector<FontFace>& faces, int weight, bool italic) {
+    const FontFace* best = nullptr;
+    int bestScore = 0;
+    for (const auto& face : faces) {
+        // A style mismatch costs more than any weight difference
+        int score = std::abs(face.weight - weight) + (face.italic == italic ? 0 : 1000);
+        if (!best || score < bestScore) {
+            best = &face;
+            bestScore = score;
+        }
+    }
+    return best ? best->metrics : nullptr;
+}
+
+} // namespace
+
+FontMetricsPtr
+FontMetrics::create(std::vector<uint8_t>&& data) {
+    auto metrics = std::make_shared<FontMetrics>();
+    metrics->mData = std::move(data);
+    if (!metrics->parse())
+        return nullptr;
+    return metrics;
+}
+
+uint16_t
+FontMetrics::u16(uint32_t offset) const {
+    // Compared without adding to the offset, which wraps near the end of the range
+    if (mData.size() < 2 || offset > mData.size() - 2)
+        return 0;
+    return static_cast<uint16_t>((mData[offset] << 8) | mData[offset + 1]);
+}
+
+uint32_t
+FontMetrics::u32(uint32_t offset) const {
+    // Compared without adding to the offset, which wraps near the end of the range
+    if (mData.size() < 4 || offset > mData.size() - 4)
+        return 0;
+    return (static_cast<uint32_t>(mData[offset]) << 24) | (static_cast<uint32_t>(mData[offset + 1]) << 16) |
+           (static_cast<uint32_t>(mData[offset + 2]) << 8) | mData[offset + 3];
+}
+
+bool
+FontMetrics::parse() {
+    auto version = u32(0);
+    if (version != TAG_TRUE_TYPE && version != TAG_APPLE_TRUE_TYPE && version != TAG_OPEN_TYPE) {
+        LOG(LogLevel::ERROR) << "Unsupported font file, only uncompressed TrueType and OpenType fonts can be measured";
+        return false;
+    }
+
+    uint32_t head = 0, hhea = 0, hmtx = 0, cmap = 0, kern = 0, gpos = 0;
+    auto numTables = u16(4);
+    for (uint16_t i = 0; i < numTables; i++) {
+        uint32_t record = 12 + i * 16;
+        auto tag = u32(record);
+        auto offset = u32(record + 8);
+        if (offset >= mData.size())
+            continue;
+        switch (tag) {
+            case TAG_HEAD: head = offset; break;
+            case TAG_HHEA: hhea = offset; break;
+            case TAG_HMTX: hmtx = offset; break;
+            case TAG_CMAP: cmap = offset; break;
+            case TAG_KERN: kern = offset; break;
+            case TAG_GPOS: gpos = offset; break;
+            default: break;
+        }
+    }
+
+    if (!head || !hhea || !hmtx || !cmap) {
+        LOG(LogLevel::ERROR) << "Font file is missing a required table";
+        return false;
+    }
+
+    mUnitsPerEm = u16(head + 18);
+    if (mUnitsPerEm == 0)
+        return false;
+
+    mAscender = s16(hhea + 4);
+    mDescender = s16(hhea + 6);
+    mLineGap = s16(hhea + 8);
+
+    auto numberOfHMetrics = u16(hhea + 34);
+    mAdvances.reserve(numberOfHMetrics);
+    for (uint16_t i = 0; i < numberOfHMetrics; i++)
+        mAdvances.push_back(u16(hmtx + i * 4));
+
+    if (!parseCmap(cmap))
+        return false;
+
+    if (kern)
+        parseKern(kern);
+    if (gpos)
+        parseGpos(gpos);
+
+    return true;
+}
+
+bool
+FontMetrics::parseCmap(uint32_t offset) {
+    // Prefer the full unicode subtable (format 12), then the BMP subtable (format 4)
+    uint32_t format4 = 0, format12 = 0;
+    auto numTables = u16(offset + 2);
+    for (uint16_t i = 0; i < numTables; i++) {
+        uint32_t record = offset + 4 + i * 8;
+        auto platformId = u16(record);
+        auto encodingId = u16(record + 2);
+        uint32_t subtable = offset + u32(record + 4);
+        bool unicode = platformId == 0 || (platformId == 3 && (encodingId == 1 || encodingId == 10));
+        if (!unicode)
+            continue;
+        auto format = u16(subtable);
+        if (format == 12 && !format12)
+            format12 = subtable;
+        else if (format == 4 && !format4)
+            format4 = subtable;
+    }
+
+    if (format12) {
+        auto numGroups = u32(format12 + 12);
+        for (uint32_t i = 0; i < numGroups; i++) {
+            uint64_t end64 = static_cast<uint64_t>(format12) + 16 + static_cast<uint64_t>(i) * 12 + 12;
+            if (end64 > mData.size())
+                break;
+            auto group = static_cast<uint32_t>(end64 - 12);
+            auto start = u32(group);
+            auto end = u32(group + 4);
+            auto glyph = u32(group + 8);
+            end = std::min(end, 0x10FFFFu);
+            if (start <= end)
+                mGlyphs.push_back({start, end, glyph});
+        }
+    } else if (format4) {
+        auto segCount = u16(format4 + 6) / 2;
+        uint32_t endCodes = format4 + 14;
+        uint32_t startCodes = endCodes + segCount * 2 + 2;
+        uint32_t idDeltas = startCodes + segCount * 2;
+        uint32_t idRangeOffsets = idDeltas + segCount * 2;
+        for (uint16_t i = 0; i < segCount; i++) {
+            uint32_t start = u16(startCodes + i * 2);
+            uint32_t end = u16(endCodes + i * 2);
+            auto idDelta = u16(idDeltas + i * 2);
+            auto idRangeOffset = u16(idRangeOffsets + i * 2);
+            end = std::min(end, 0xFFFEu);
+            if (start > end)
+                continue;
+            if (idRangeOffset == 0) {
+                mGlyphs.push_back({start, end, static_cast<uint16_t>(start + idDelta)});
+                continue;
+            }
+            for (auto c = start; c <= end; c++) {
+                uint16_t glyph = u16(idRangeOffsets + i * 2 + idRangeOffset + (c - start) * 2);
+                if (glyph != 0)
+                    mGlyphs.push_back({c, c, static_cast<uint16_t>(glyph + idDelta)});
+            }
+        }
+    } else {
+        LOG(LogLevel::ERROR) << "Font file has no unicode character map";
+        return false;
+    }
+
+    std::sort(mGlyphs.begin(), mGlyphs.end());
+    for (const auto& range : mGlyphs) {
+        if (range.start >= 128)
+            break;
+        for (auto c = range.start; c <= range.end && c < 128; c++)
+            mAsciiGlyphs[c] = static_cast<uint16_t>(range.glyph + (c - range.start));
+    }
+    return true;
+}
+
+void
+FontMetrics::parseKern(uint32_t offset) {
+    // Only the horizontal format 0 subtables of the version 0 (Microsoft) table are read
+    if (u16(offset) != 0)
+        return;
+
+    auto numTables = u16(offset + 2);
+    uint32_t subtable = offset + 4;
+    for (uint16_t i = 0; i < numTables && subtable < mData.size(); i++) {
+        auto length = u16(subtable + 2);
+        auto coverage = u16(subtable + 4);
+        bool horizontal = coverage & 0x1;
+        bool format0 = (coverage >> 8) == 0;
+        if (horizontal && format0) {
+            auto nPairs = u16(subtable + 6);
+            for (uint16_t pair = 0; pair < nPairs; pair++) {
+                uint32_t record = subtable + 14 + pair * 6;
+                mKerning.emplace(pairKey(u16(record), u16(record + 2)), s16(record + 4));
+            }
+        }
+        if (length == 0)
+            break;
+        subtable += length;
+    }
+}
+
+void
+FontMetrics::parseGpos(uint32_t offset) {
+    // Collect the pair positioning subtables of every lookup referenced by a 'kern' feature
+    uint32_t featureList = offset + u16(offset + 6);
+    uint32_t lookupList = offset + u16(offset + 8);
+    std::vector<uint16_t> lookups;
+
+    auto featureCount = u16(featureList);
+    for (uint16_t i = 0; i < featureCount; i++) {
+        uint32_t record = featureList + 2 + i * 6;
+        if (u32(record) != TAG_KERN)
+            continue;
+        uint32_t feature = featureList + u16(record + 4);
+        auto lookupCount = u16(feature + 2);
+        for (uint16_t j = 0; j < lookupCount; j++)
+            lookups.push_back(u16(feature + 4 + j * 2));
+    }
+
+    std::sort(lookups.begin(), lookups.end());
+    lookups.erase(std::unique(lookups.begin(), lookups.end()), lookups.end());
+
+    auto lookupCount = u16(lookupList);
+    for (auto index : lookups) {
+        if (index >= lookupCount)
+            continue;
+        uint32_t lookup = lookupList + u16(lookupList + 2 + index * 2);
+        auto lookupType = u16(lookup);
+        auto subTableCount = u16(lookup + 4);
+        for (uint16_t i = 0; i < subTableCount; i++) {
+            uint32_t subtable = lookup + u16(lookup + 6 + i * 2);
+            if (lookupType == LOOKUP_EXTENSION) {
+                if (u16(subtable + 2) != LOOKUP_PAIR_POSITIONING)
+                    continue;
+                subtable += u32(subtable + 4);
+            } else if (lookupType != LOOKUP_PAIR_POSITIONING) {
+                continue;
+            }
+            mPairPositioning.push_back(subtable);
+        }
+    }
+}
+
+int
+FontMetrics::coverageIndex(uint32_t offset, uint16_t glyph) const {
+    auto format = u16(offset);
+    auto count = u16(offset + 2);
+    if (format == 1) {
+        int low = 0, high = count - 1;
+        while (low <= high) {
+            int mid = (low + high) / 2;
+            auto value = u16(offset + 4 + mid * 2);
+            if (value == glyph)
+                return mid;
+            if (value < glyph)
+                low = mid + 1;
+            else
+                high = mid - 1;
+        }
+    } else if (format == 2) {
+        int low = 0, high = count - 1;
+        while (low <= high) {
+            int mid = (low + high) / 2;
+            uint32_t range = offset + 4 + mid * 6;
+            auto start = u16(range);
+            auto end = u16(range + 2);
+            if (glyph < start)
+                high = mid - 1;
+            else if (glyph > end)
+                low = mid + 1;
+            else
+                return u16(range + 4) + (glyph - start);
+        }
+    }
+    return -1;
+}
+
+uint16_t
+FontMetrics::glyphClass(uint32_t offset, uint16_t glyph) const {
+    auto format = u16(offset);
+    if (format == 1) {
+        auto startGlyph = u16(offset + 2);
+        auto glyphCount = u16(offset + 4);
+        if (glyph >= startGlyph && glyph < startGlyph + glyphCount)
+            return u16(offset + 6 + (glyph - startGlyph) * 2);
+    } else if (format == 2) {
+        auto count = u16(offset + 2);
+        int low = 0, high = count - 1;
+        while (low <= high) {
+            int mid = (low + high) / 2;
+            uint32_t range = offset + 4 + mid * 6;
+            auto start = u16(range);
+            auto end = u16(range + 2);
+            if (glyph < start)
+                high = mid - 1;
+            else if (glyph > end)
+                low = mid + 1;
+            else
+                return u16(range + 4);
+        }
+    }
+    return 0;
+}
+
+int16_t
+FontMetrics::gposKerning(uint16_t left, uint16_t right) const {
+    for (auto subtable : mPairPositioning) {
+        auto format = u16(subtable);
+        auto coverage = coverageIndex(subtable + u16(subtable + 2), left);
+        if (coverage < 0)
+            continue;
+
+        auto valueFormat1 = u16(subtable + 4);
+        auto valueFormat2 = u16(subtable + 6);
+        auto advanceOffset = xAdvanceOffset(valueFormat1);
+        auto recordSize = valueRecordSize(valueFormat1) + valueRecordSize(valueFormat2);
+
+        if (format == 1) {
+            if (coverage >= u16(subtable + 8))
+                continue;
+            uint32_t pairSet = subtable + u16(subtable + 10 + coverage * 2);
+            auto pairValueCount = u16(pairSet);
+            int low = 0, high = pairValueCount - 1;
+            while (low <= high) {
+                int mid = (low + high) / 2;
+                uint32_t record = pairSet + 2 + mid * (2 + recordSize);
+                auto secondGlyph = u16(record);
+                if (secondGlyph == right)
+                    return advanceOffset < 0 ? 0 : s16(record + 2 + advanceOffset);
+                if (secondGlyph < right)
+                    low = mid + 1;
+                else
+                    high = mid - 1;
+            }
+        } else if (format == 2) {
+            auto class1 = glyphClass(subtable + u16(subtable + 8), left);
+            auto class2 = glyphClass(subtable + u16(subtable + 10), right);
+            auto class1Count = u16(subtable + 12);
+            auto class2Count = u16(subtable + 14);
+            if (class1 >= class1Count || class2 >= class2Count)
+                continue;
+            // Class pair subtables cover every pair of their glyphs, so the first hit is final
+            uint32_t record = subtable + 16 + (class1 * class2Count + class2) * recordSize;
+            return advanceOffset < 0 ? 0 : s16(record + advanceOffset);
+        }
+    }
+    return 0;
+}
+
+uint16_t
+FontMetrics::glyph(uint32_t codepoint) const {
+    if (codepoint < 128)
+        return mAsciiGlyphs[codepoint];
+
+    // Last range starting at or before the code point
+    auto it = std::upper_bound(mGlyphs.begin(), mGlyphs.end(), GlyphRange{codepoint, codepoint, 0});
+    if (it == mGlyphs.begin())
+        return 0;
+    --it;
+    if (codepoint > it->end)
+        return 0;
+    return static_cast<uint16_t>(it->glyph + (codepoint - it->start));
+}
+
+uint16_t
+FontMetrics::advance(uint16_t glyph) const {
+    if (mAdvances.empty())
+        return 0;
+    return glyph < mAdvances.size() ? mAdvances[glyph] : mAdvances.back();
+}
+
+int16_t
+FontMetrics::kerning(uint16_t left, uint16_t right) const {
+    auto key = pairKey(left, right);
+    auto it = mKerning.find(key);
+    if (it != mKerning.end())
+        return it->second;
+
+    if (mPairPositioning.empty())
+        return 0;
+
+    auto cached = mGposKerning.find(key);
+    if (cached != mGposKerning.end())
+        return cached->second;
+
+    auto value = gposKerning(left, right);
+    mGposKerning.emplace(key, value);
+    return value;
+}
+
+bool
+FontRegistry::registerFont(const std::string& family, int weight, bool italic, emscripten::val data) {
+    auto bytes = data.instanceof(emscripten::val::global("ArrayBuffer"))
+        ? emscripten::val::global("Uint8Array").new_(data)
+        : emscripten::val::global("Uint8Array").new_(data["buffer"], data["byteOffset"], data["byteLength"]);
+
+    auto length = bytes["length"].as<size_t>();
+    std::vector<uint8_t> buffer(length);
+    emscripten::val(emscripten::typed_memory_view(length, buffer.data())).call<void>("set", bytes);
+
+    auto metrics = FontMetrics::create(std::move(buffer));
+    if (!metrics) {
+        LOG(LogLevel::ERROR) << "Failed to register font " << family;
+        return false;
+    }
+
+    auto& faces = registeredFonts()[normalizeFamily(family)];
+    faces.erase(std::remove_if(faces.begin(), faces.end(), [&](const FontFace& face) {
+        return face.weight == weight && face.italic == italic;
+    }), faces.end());
+    faces.push_back({weight, italic, metrics});
+    return true;
+}
+
+FontMetricsPtr
+FontRegistry::find(const std::vector<std::string>& families, int weight, bool italic) {
+    auto& fonts = registeredFonts();
+    for (const auto& family : families) {
+        auto it = fonts.find(normalizeFamily(family));
+        if (it != fonts.end())
+            return closestFace(it->second, weight, italic);
+    }
+
+    auto fallback = fonts.find(FALLBACK_FAMILY);
+    if (fallback != fonts.end())
+        return closestFace(fallback->second, weight, italic);
+
+    return fonts.empty() ? nullptr : closestFace(fonts.begin()->second, weight, italic);
+}
+
+bool
+FontRegistry::hasFonts() {
+    return !registeredFonts().empty();
+}
+
+void
+FontRegistry::clear() {
+    registeredFonts().clear();
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_font_registry) {
+
+    emscripten::class_<FontRegistry>("FontRegistry")
+        .class_function("registerFont", &FontRegistry::registerFont)
+        .class_function("hasFonts", &FontRegistry::hasFonts)
+        .class_function("clear", &FontRegistry::clear);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,115 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/framedelta.h"
+#include "wasm/embindutils.h"
+#include "wasm/propertyconversion.h"
+#include "wasm/wasmmetrics.h"
+
+namespace apl {
+namespace wasm {
+
+emscripten::val
+FrameDelta::collect(const std::set<ComponentPtr>& dirty, WASMMetrics* metrics) {
+    mBuffer.clear();
+    mStrings.clear();
+    mObjectCount = 0;
+    auto objects = emscripten::val::array();
+
+    mBuffer.push_back(dirty.size());
+    mBuffer.push_back(0);
+    for (auto& component : dirty) {
+        const auto& uniqueId = component->getUniqueId();
+        mBuffer.push_back(addString(uniqueId));
+        mBuffer.push_back(uniqueId.size());
+    }
+
+    size_t componentIndex = 0;
+    size_t recordCount = 0;
+    for (auto& component : dirty) {
+        for (PropertyKey key : component->getDirty()) {
+            addRecord(componentIndex, key, component->getCalculated(key), metrics, objects);
+            recordCount++;
+        }
+        componentIndex++;
+    }
+    mBuffer[1] = recordCount;
+
+    auto delta = emscripten::val::object();
+    delta.set("buffer", emscripten::val(emscripten::typed_memory_view(mBuffer.size(), mBuffer.data())));
+    delta.set("strings", emscripten::val(emscripten::typed_memory_view(
+        mStrings.size(), reinterpret_cast<const uint8_t*>(mStrings.data()))));
+    delta.set("objects", objects);
+    return delta;
+}
+
+void
+FrameDelta::addRecord(size_t componentIndex, PropertyKey key, const Object& value,
+                      WASMMetrics* metrics, emscripten::val& objects) {
+    mBuffer.push_back(componentIndex);
+    mBuffer.push_back(static_cast<int>(key));
+
+    auto kind = PropertyConversion::lookup(key, value);
+    switch (kind) {
+        case kConversionNumber:
+            addPayload(kValueKindNumber, value.getDouble());
+            break;
+        case kConversionBoolean:
+            addPayload(kValueKindBoolean, value.getBoolean() ? 1 : 0);
+            break;
+        case kConversionString: {
+            const auto& str = value.getString();
+            addPayload(kValueKindString, addString(str), str.size());
+            break;
+        }
+        case kConversionColor:
+            addPayload(kValueKindColor, value.getColor());
+            break;
+        case kConversionAbsoluteDimension:
+            addPayload(kValueKindNumber, value.getAbsoluteDimension() * metrics->getViewhostScale());
+            break;
+        case kConversionRadii: {
+            auto radii = metrics->toViewhostRadii(value.get<Radii>());
+            addPayload(kValueKindRadii, radii.topLeft(), radii.topRight(), radii.bottomLeft(), radii.bottomRight());
+            break;
+        }
+        case kConversionRect: {
+            auto rect = metrics->toViewhostRect(value.get<Rect>());
+            addPayload(kValueKindRect, rect.getX(), rect.getY(), rect.getWidth(), rect.getHeight());
+            break;
+        }
+        case kConversionTransform2D: {
+            auto str = emscripten::getTransformString(value.get<Transform2D>());
+            addPayload(kValueKindString, addString(str), str.size());
+            break;
+        }
+        case kConversionUndefined:
+            addPayload(kValueKindUndefined);
+            break;
+        default:
+            objects.call<void>("push", emscripten::getValFromObject(value, kind, metrics));
+            addPayload(kValueKindObject, mObjectCount++);
+            break;
+    }
+}
+
+void
+FrameDelta::addPayload(ValueKind kind, double p0, double p1, double p2, double p3) {
+    mBuffer.push_back(kind);
+    mBuffer.push_back(p0);
+    mBuffer.push_back(p1);
+    mBuffer.push_back(p2);
+    mBuffer.push_back(p3);
+}
+
+size_t
+FrameDelta::addString(const std::string& value) {
+    auto offset = mStrings.size();
+    mStrings.append(value);
+    return offset;
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,89 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/jsonbridge.h"
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+// A visual context this size is rare, do not keep the memory around after it
+const size_t MAX_RETAINED_CAPACITY = 1 << 20;
+
+rapidjson::StringBuffer&
+sharedBuffer() {
+    static rapidjson::StringBuffer buffer;
+    return buffer;
+}
+
+void
+write(const rapidjson::Value& value, rapidjson::StringBuffer& buffer) {
+    bool shrink = buffer.GetSize() > MAX_RETAINED_CAPACITY;
+    buffer.Clear();
+    if (shrink)
+        buffer.ShrinkToFit();
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+}
+
+} // namespace
+
+emscripten::val
+JsonBridge::convert(const rapidjson::Value& value, int mode) {
+    switch (mode) {
+        case kModeView:
+            return toView(value);
+        case kModeObject:
+            return toObject(value);
+        default: {
+            auto& buffer = sharedBuffer();
+            write(value, buffer);
+            return emscripten::val(std::string(buffer.GetString(), buffer.GetSize()));
+        }
+    }
+}
+
+emscripten::val
+JsonBridge::toView(const rapidjson::Value& value) {
+    auto& buffer = sharedBuffer();
+    write(value, buffer);
+    return emscripten::val(emscripten::typed_memory_view(buffer.GetSize(),
+                                                         reinterpret_cast<const uint8_t*>(buffer.GetString())));
+}
+
+emscripten::val
+JsonBridge::toObject(const rapidjson::Value& value) {
+    switch (value.GetType()) {
+        case rapidjson::kNullType:
+            return emscripten::val::null();
+        case rapidjson::kFalseType:
+            return emscripten::val(false);
+        case rapidjson::kTrueType:
+            return emscripten::val(true);
+        case rapidjson::kStringType:
+            return emscripten::val(std::string(value.GetString(), value.GetStringLength()));
+        case rapidjson::kNumberType:
+            return emscripten::val(value.GetDouble());
+        case rapidjson::kArrayType: {
+            auto result = emscripten::val::array();
+            for (rapidjson::SizeType i = 0; i < value.Size(); i++)
+                result.set(i, toObject(value[i]));
+            return result;
+        }
+        case rapidjson::kObjectType: {
+            auto result = emscripten::val::object();
+            for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it)
+                result.set(std::string(it->name.GetString(), it->name.GetStringLength()), toObject(it->value));
+            return result;
+        }
+    }
+    return emscripten::val::undefined();
+}
+
+} // namespace wasm
+} // namespace apl
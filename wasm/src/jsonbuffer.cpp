@@ -0,0 +1,202 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/jsonbuffer.h"
+#include "apl/utils/log.h"
+#include <unordered_map>
+#include <zlib.h>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+struct Buffer {
+    std::unique_ptr<char[]> data;
+    size_t length;
+};
+
+/**
+ * A document parsed in situ and the buffer holding its strings.
+ */
+struct ParsedBuffer {
+    std::unique_ptr<char[]> data;
+    rapidjson::Document document;
+};
+
+/**
+ * rapidjson input stream inflating gzip or zlib data a chunk at a time. Corrupt or truncated data
+ * ends the stream early, which the reader reports as a parse error.
+ */
+class InflateStream {
+public:
+    typedef char Ch;
+
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    InflateStream(const char* data, size_t length) : mChunk(new char[CHUNK_SIZE]) {
+        mStream.zalloc = Z_NULL;
+        mStream.zfree = Z_NULL;
+        mStream.opaque = Z_NULL;
+        mStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        mStream.avail_in = length;
+        // 32 detects the gzip or zlib header
+        mDone = inflateInit2(&mStream, 15 + 32) != Z_OK;
+        mFailed = mDone;
+        mCurrent = mEnd = mChunk.get();
+        fill();
+    }
+
+    ~InflateStream() {
+        inflateEnd(&mStream);
+    }
+
+    Ch Peek() const { return mCurrent < mEnd ? *mCurrent : '\0'; }
+
+    Ch Take() {
+        if (mCurrent == mEnd)
+            return '\0';
+        auto c = *mCurrent++;
+        mCount++;
+        if (mCurrent == mEnd)
+            fill();
+        return c;
+    }
+
+    size_t Tell() const { return mCount; }
+
+    Ch* PutBegin() { RAPIDJSON_ASSERT(false); return nullptr; }
+    void Put(Ch) { RAPIDJSON_ASSERT(false); }
+    void Flush() { RAPIDJSON_ASSERT(false); }
+    size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+
+    bool failed() const { return mFailed; }
+
+private:
+    void fill() {
+        mCurrent = mEnd = mChunk.get();
+        while (!mDone && mCurrent == mEnd) {
+            mStream.next_out = reinterpret_cast<Bytef*>(mChunk.get());
+            mStream.avail_out = CHUNK_SIZE;
+            auto status = inflate(&mStream, Z_NO_FLUSH);
+            mEnd = mChunk.get() + (CHUNK_SIZE - mStream.avail_out);
+            if (status == Z_STREAM_END) {
+                mDone = true;
+            } else if (status != Z_OK) {
+                mDone = true;
+                mFailed = true;
+            }
+        }
+    }
+
+    z_stream mStream;
+    std::unique_ptr<char[]> mChunk;
+    const char* mCurrent;
+    const char* mEnd;
+    size_t mCount = 0;
+    bool mDone;
+    bool mFailed;
+};
+
+std::unordered_map<uintptr_t, Buffer>&
+buffers() {
+    static std::unordered_map<uintptr_t, Buffer> allocated;
+    return allocated;
+}
+
+} // namespace
+
+uintptr_t
+JsonBuffer::allocate(size_t length) {
+    // One more byte for the terminating NUL that in situ parsing needs
+    std::unique_ptr<char[]> data(new (std::nothrow) char[length + 1]);
+    if (!data) {
+        LOG(LogLevel::ERROR) << "Unable to allocate a JSON buffer of " << length << " bytes";
+        return 0;
+    }
+
+    auto address = reinterpret_cast<uintptr_t>(data.get());
+    buffers().emplace(address, Buffer{std::move(data), length});
+    return address;
+}
+
+uintptr_t
+JsonBuffer::fromArray(emscripten::val array) {
+    auto length = array["length"].as<size_t>();
+    auto address = allocate(length);
+    if (address) {
+        auto view = emscripten::val(emscripten::typed_memory_view(length, reinterpret_cast<uint8_t*>(address)));
+        view.call<void>("set", array);
+    }
+    return address;
+}
+
+void
+JsonBuffer::free(uintptr_t address) {
+    buffers().erase(address);
+}
+
+std::unique_ptr<char[]>
+JsonBuffer::release(uintptr_t address, size_t& length) {
+    auto& allocated = buffers();
+    auto it = allocated.find(address);
+    if (it == allocated.end()) {
+        LOG(LogLevel::ERROR) << "Unknown JSON buffer";
+        return nullptr;
+    }
+
+    auto data = std::move(it->second.data);
+    if (length > it->second.length)
+        length = it->second.length;
+    allocated.erase(it);
+    return data;
+}
+
+std::shared_ptr<rapidjson::Document>
+JsonBuffer::parse(uintptr_t address, size_t length) {
+    auto data = release(address, length);
+    if (!data)
+        return nullptr;
+
+    auto parsed = std::make_shared<ParsedBuffer>();
+    parsed->data = std::move(data);
+    parsed->data[length] = '\0';
+    parsed->document.ParseInsitu(parsed->data.get());
+    if (parsed->document.HasParseError())
+        LOG(LogLevel::ERROR) << "JSON buffer parse error at offset " << parsed->document.GetErrorOffset();
+
+    // The document shares the ownership of the buffer holding its strings
+    return std::shared_ptr<rapidjson::Document>(parsed, &parsed->document);
+}
+
+std::shared_ptr<rapidjson::Document>
+JsonBuffer::parseCompressed(uintptr_t address, size_t length) {
+    auto data = release(address, length);
+    if (!data)
+        return nullptr;
+
+    auto document = std::make_shared<rapidjson::Document>();
+    InflateStream stream(data.get(), length);
+    document->ParseStream(stream);
+    // Data past a corrupt block is lost, even when the JSON read so far happens to be complete
+    if (stream.failed()) {
+        LOG(LogLevel::ERROR) << "Corrupt or truncated compressed JSON buffer";
+        return nullptr;
+    }
+    if (document->HasParseError())
+        LOG(LogLevel::ERROR) << "Compressed JSON buffer parse error at offset " << document->GetErrorOffset();
+    return document;
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_json_buffer) {
+
+    emscripten::class_<JsonBuffer>("JsonBuffer")
+        .class_function("allocate", &JsonBuffer::allocate)
+        .class_function("fromArray", &JsonBuffer::fromArray)
+        .class_function("free", &JsonBuffer::free);
+}
+
+} // namespace wasm
+} // namespace apl
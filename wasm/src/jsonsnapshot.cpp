@@ -0,0 +1,260 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/jsonsnapshot.h"
+#include <cstring>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const uint8_t MAGIC[4] = {'A', 'P', 'L', 'J'};
+const size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 8 + 4;
+const int MAX_DEPTH = 512;
+
+enum Tag : uint8_t {
+    kTagNull = 0,
+    kTagFalse,
+    kTagTrue,
+    kTagInt64,
+    kTagUint64,
+    kTagDouble,
+    kTagString,
+    kTagArray,
+    kTagObject
+};
+
+template<typename T>
+void
+put(std::vector<uint8_t>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); i++)
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+void
+putString(std::vector<uint8_t>& out, const char* str, size_t length) {
+    put<uint32_t>(out, length);
+    out.insert(out.end(), str, str + length);
+    out.push_back(0);
+}
+
+void
+encodeValue(std::vector<uint8_t>& out, const rapidjson::Value& value) {
+    switch (value.GetType()) {
+        case rapidjson::kNullType:
+            out.push_back(kTagNull);
+            break;
+        case rapidjson::kFalseType:
+            out.push_back(kTagFalse);
+            break;
+        case rapidjson::kTrueType:
+            out.push_back(kTagTrue);
+            break;
+        case rapidjson::kNumberType:
+            if (value.IsInt64()) {
+                out.push_back(kTagInt64);
+                put<uint64_t>(out, static_cast<uint64_t>(value.GetInt64()));
+            } else if (value.IsUint64()) {
+                out.push_back(kTagUint64);
+                put<uint64_t>(out, value.GetUint64());
+            } else {
+                out.push_back(kTagDouble);
+                uint64_t bits;
+                double number = value.GetDouble();
+                std::memcpy(&bits, &number, sizeof(bits));
+                put<uint64_t>(out, bits);
+            }
+            break;
+        case rapidjson::kStringType:
+            out.push_back(kTagString);
+            putString(out, value.GetString(), value.GetStringLength());
+            break;
+        case rapidjson::kArrayType:
+            out.push_back(kTagArray);
+            put<uint32_t>(out, value.Size());
+            for (const auto& element : value.GetArray())
+                encodeValue(out, element);
+            break;
+        case rapidjson::kObjectType:
+            out.push_back(kTagObject);
+            put<uint32_t>(out, value.MemberCount());
+            for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+                putString(out, it->name.GetString(), it->name.GetStringLength());
+                encodeValue(out, it->value);
+            }
+            break;
+    }
+}
+
+/**
+ * Replays a tape into a rapidjson handler. Strings are handed over without copy.
+ */
+class TapeReader {
+public:
+    TapeReader(const uint8_t* data, size_t size) : mData(data), mSize(size) {}
+
+    template<typename Handler>
+    bool operator()(Handler& handler) {
+        mComplete = value(handler, 0) && mPosition == mSize;
+        return mComplete;
+    }
+
+    bool isComplete() const { return mComplete; }
+
+private:
+    template<typename T>
+    bool get(T& value) {
+        if (mSize - mPosition < sizeof(T))
+            return false;
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+            value |= static_cast<T>(mData[mPosition + i]) << (8 * i);
+        mPosition += sizeof(T);
+        return true;
+    }
+
+    bool getString(const char*& str, uint32_t& length) {
+        if (!get(length) || mSize - mPosition < static_cast<size_t>(length) + 1 || mData[mPosition + length] != 0)
+            return false;
+        str = reinterpret_cast<const char*>(mData + mPosition);
+        mPosition += length + 1;
+        return true;
+    }
+
+    template<typename Handler>
+    bool value(Handler& handler, int depth) {
+        if (depth > MAX_DEPTH || mPosition >= mSize)
+            return false;
+
+        const char* str;
+        uint32_t length;
+        uint64_t bits;
+        switch (mData[mPosition++]) {
+            case kTagNull:
+                return handler.Null();
+            case kTagFalse:
+                return handler.Bool(false);
+            case kTagTrue:
+                return handler.Bool(true);
+            case kTagInt64:
+                return get(bits) && handler.Int64(static_cast<int64_t>(bits));
+            case kTagUint64:
+                return get(bits) && handler.Uint64(bits);
+            case kTagDouble: {
+                if (!get(bits))
+                    return false;
+                double number;
+                std::memcpy(&number, &bits, sizeof(number));
+                return handler.Double(number);
+            }
+            case kTagString:
+                return getString(str, length) && handler.String(str, length, false);
+            case kTagArray: {
+                uint32_t count;
+                if (!get(count) || !handler.StartArray())
+                    return false;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (!value(handler, depth + 1))
+                        return false;
+                }
+                return handler.EndArray(count);
+            }
+            case kTagObject: {
+                uint32_t count;
+                if (!get(count) || !handler.StartObject())
+                    return false;
+                for (uint32_t i = 0; i < count; i++) {
+                    if (!getString(str, length) || !handler.Key(str, length, false) || !value(handler, depth + 1))
+                        return false;
+                }
+                return handler.EndObject(count);
+            }
+            default:
+                return false;
+        }
+    }
+
+    const uint8_t* mData;
+    size_t mSize;
+    size_t mPosition = 0;
+    bool mComplete = false;
+};
+
+template<typename T>
+T
+read(const uint8_t* data) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+        value |= static_cast<T>(data[i]) << (8 * i);
+    return value;
+}
+
+} // namespace
+
+uint64_t
+JsonSnapshot::hash(const uint8_t* data, size_t size) {
+    uint64_t result = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        result ^= data[i];
+        result *= 0x100000001b3ULL;
+    }
+    return result;
+}
+
+std::vector<uint8_t>
+JsonSnapshot::encode(const rapidjson::Value& value, const std::string& reference) {
+    std::vector<uint8_t> body;
+    encodeValue(body, value);
+
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + reference.size() + body.size());
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put<uint16_t>(out, FORMAT_VERSION);
+    put<uint16_t>(out, 0);
+    put<uint32_t>(out, body.size());
+    put<uint64_t>(out, hash(body.data(), body.size()));
+    put<uint32_t>(out, reference.size());
+    out.insert(out.end(), reference.begin(), reference.end());
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+std::shared_ptr<rapidjson::Document>
+JsonSnapshot::decode(std::vector<uint8_t>&& data, const std::string& reference) {
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0)
+        return nullptr;
+
+    const auto* header = data.data() + sizeof(MAGIC);
+    auto formatVersion = read<uint16_t>(header);
+    auto bodySize = read<uint32_t>(header + 4);
+    auto bodyHash = read<uint64_t>(header + 8);
+    auto referenceSize = read<uint32_t>(header + 16);
+    // Summed in 64 bits, the sizes read from the header may overflow a 32 bit size_t
+    if (formatVersion != FORMAT_VERSION ||
+        static_cast<uint64_t>(data.size()) != static_cast<uint64_t>(HEADER_SIZE) + referenceSize + bodySize)
+        return nullptr;
+
+    const auto* imageReference = reinterpret_cast<const char*>(data.data() + HEADER_SIZE);
+    if (!reference.empty() && referenceSize > 0 && reference.compare(0, std::string::npos, imageReference, referenceSize) != 0)
+        return nullptr;
+
+    const auto* body = data.data() + HEADER_SIZE + referenceSize;
+    if (hash(body, bodySize) != bodyHash)
+        return nullptr;
+
+    auto image = std::make_shared<Image>();
+    image->data = std::move(data);
+    TapeReader reader(image->data.data() + HEADER_SIZE + referenceSize, bodySize);
+    image->document.Populate(reader);
+    if (!reader.isComplete())
+        return nullptr;
+
+    // The document shares the ownership of the image holding its strings
+    return std::shared_ptr<rapidjson::Document>(image, &image->document);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,110 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/keytable.h"
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+// KeyboardEvent.code values and named KeyboardEvent.key values sent by keyboards and remotes
+const char* PRELOADED_STRINGS[] = {
+    "",
+    "Enter", "Tab", "Space", " ", "Backspace", "Escape", "Delete", "Insert",
+    "ArrowUp", "ArrowDown", "ArrowLeft", "ArrowRight", "Home", "End", "PageUp", "PageDown",
+    "ShiftLeft", "ShiftRight", "ControlLeft", "ControlRight", "AltLeft", "AltRight", "MetaLeft", "MetaRight",
+    "Shift", "Control", "Alt", "Meta", "CapsLock", "ContextMenu",
+    "Minus", "Equal", "BracketLeft", "BracketRight", "Backslash", "Semicolon", "Quote", "Backquote",
+    "Comma", "Period", "Slash",
+    "NumpadAdd", "NumpadSubtract", "NumpadMultiply", "NumpadDivide", "NumpadDecimal", "NumpadEnter",
+    "MediaPlayPause", "MediaPlay", "MediaPause", "MediaStop", "MediaTrackNext", "MediaTrackPrevious",
+    "MediaFastForward", "MediaRewind", "AudioVolumeUp", "AudioVolumeDown", "AudioVolumeMute",
+    "BrowserBack", "GoBack", "Unidentified",
+};
+
+struct Table {
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, int> ids;
+
+    Table() {
+        for (auto value : PRELOADED_STRINGS)
+            add(value);
+        for (char c = 'A'; c <= 'Z'; c++) {
+            add(std::string("Key") + c);
+            add(std::string(1, c));
+            add(std::string(1, static_cast<char>(c - 'A' + 'a')));
+        }
+        for (char c = '0'; c <= '9'; c++) {
+            add(std::string("Digit") + c);
+            add(std::string("Numpad") + c);
+            add(std::string(1, c));
+        }
+        for (int i = 1; i <= 12; i++)
+            add("F" + std::to_string(i));
+    }
+
+    int add(const std::string& value) {
+        auto it = ids.find(value);
+        if (it != ids.end())
+            return it->second;
+        if (strings.size() >= KeyTable::MAX_STRINGS)
+            return -1;
+        int id = strings.size();
+        strings.push_back(value);
+        ids.emplace(value, id);
+        return id;
+    }
+};
+
+Table&
+table() {
+    static Table keyTable;
+    return keyTable;
+}
+
+} // namespace
+
+int
+KeyTable::intern(const std::string& value) {
+    return table().add(value);
+}
+
+const std::string&
+KeyTable::get(int id) {
+    const auto& strings = table().strings;
+    return id > 0 && id < static_cast<int>(strings.size()) ? strings[id] : strings[0];
+}
+
+emscripten::val
+KeyTable::getStrings() {
+    const auto& strings = table().strings;
+    auto result = emscripten::val::array();
+    for (size_t i = 0; i < strings.size(); i++)
+        result.set(i, strings[i]);
+    return result;
+}
+
+Keyboard
+KeyTable::keyboard(int codeId, int keyId, int modifiers) {
+    Keyboard kbd(get(codeId), get(keyId));
+    kbd.repeat((modifiers & kModifierRepeat) != 0);
+    kbd.alt((modifiers & kModifierAlt) != 0);
+    kbd.ctrl((modifiers & kModifierCtrl) != 0);
+    kbd.meta((modifiers & kModifierMeta) != 0);
+    kbd.shift((modifiers & kModifierShift) != 0);
+    return kbd;
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_key_table) {
+
+    emscripten::class_<KeyTable>("KeyTable")
+        .class_function("intern", &KeyTable::intern)
+        .class_function("getStrings", &KeyTable::getStrings);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -0,0 +1,326 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/nativetextmeasurement.h"
+#include "wasm/edittextbox.h"
+#include "wasm/textlayout.h"
+#include "apl/utils/log.h"
+#include <cmath>
+#include <limits>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const uint32_t ELLIPSIS = 0x2026;
+const char ELLIPSIS_UTF8[] = "\xE2\x80\xA6";
+const uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+// Without a registered font, assume average glyph proportions so layout still progresses
+const float FALLBACK_ADVANCE = 0.5f;
+const float FALLBACK_ASCENT = 0.8f;
+const float FALLBACK_DESCENT = 0.2f;
+
+struct Character {
+    uint32_t codepoint;
+    size_t offset;
+    size_t length;
+    float advance;
+    float kerning;
+};
+
+struct Line {
+    size_t begin;
+    size_t end;
+    float width;
+};
+
+inline bool
+isSpace(uint32_t codepoint) {
+    return codepoint == ' ' || codepoint == '\t' || codepoint == '\n' || codepoint == 0x3000;
+}
+
+inline bool
+isBreakAfter(uint32_t codepoint) {
+    // Spaces and hyphens, plus the ideographic and syllabic scripts that break between characters
+    return isSpace(codepoint) || codepoint == '-' ||
+           (codepoint >= 0x2E80 && codepoint <= 0x9FFF) ||
+           (codepoint >= 0xAC00 && codepoint <= 0xD7AF) ||
+           (codepoint >= 0xF900 && codepoint <= 0xFAFF);
+}
+
+std::vector<Character>
+decodeUtf8(const std::string& text) {
+    std::vector<Character> result;
+    result.reserve(text.size());
+
+    size_t i = 0;
+    while (i < text.size()) {
+        auto lead = static_cast<uint8_t>(text[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        uint32_t codepoint = REPLACEMENT_CHARACTER;
+        if (length == 0 || i + length > text.size()) {
+            length = 1;
+        } else {
+            codepoint = length == 1 ? lead : lead & (0xFF >> (length + 1));
+            for (size_t j = 1; j < length; j++)
+                codepoint = (codepoint << 6) | (static_cast<uint8_t>(text[i + j]) & 0x3F);
+        }
+        result.push_back({codepoint, i, length, 0, 0});
+        i += length;
+    }
+    return result;
+}
+
+/**
+ * Per measurement font state: the resolved face and its scale for the requested size.
+ */
+class Typesetter {
+public:
+    explicit Typesetter(const apl::sg::TextPropertiesPtr& textProperties)
+        : mFont(FontRegistry::find(textProperties->fontFamily(),
+                                   textProperties->fontWeight(),
+                                   textProperties->fontStyle() == apl::kFontStyleItalic)),
+          mFontSize(textProperties->fontSize()),
+          mLetterSpacing(textProperties->letterSpacing()),
+          mLineSpace(textProperties->fontSize() * textProperties->lineHeight()),
+          mScale(mFont ? mFontSize / mFont->unitsPerEm() : 0)
+    {
+        if (!mFont && !sWarned) {
+            LOG(LogLevel::WARN) << "No font registered for native text measurement, using estimated metrics";
+            sWarned = true;
+        }
+    }
+
+    void shape(std::vector<Character>& characters) const {
+        uint16_t previous = 0;
+        for (auto& character : characters) {
+            if (!mFont) {
+                character.advance = mFontSize * FALLBACK_ADVANCE + mLetterSpacing;
+                continue;
+            }
+            auto glyph = mFont->glyph(character.codepoint);
+            character.advance = mFont->advance(glyph) * mScale + mLetterSpacing;
+            character.kerning = previous ? mFont->kerning(previous, glyph) * mScale : 0;
+            previous = glyph;
+        }
+    }
+
+    float advance(uint32_t codepoint) const {
+        if (!mFont)
+            return mFontSize * FALLBACK_ADVANCE + mLetterSpacing;
+        return mFont->advance(mFont->glyph(codepoint)) * mScale + mLetterSpacing;
+    }
+
+    float ascent() const { return mFont ? mFont->ascender() * mScale : mFontSize * FALLBACK_ASCENT; }
+    float descent() const { return mFont ? -mFont->descender() * mScale : mFontSize * FALLBACK_DESCENT; }
+    float lineSpace() const { return mLineSpace; }
+
+    float baseline() const {
+        auto halfLeading = (mLineSpace - ascent() - descent()) / 2;
+        return halfLeading + ascent();
+    }
+
+private:
+    static bool sWarned;
+
+    FontMetricsPtr mFont;
+    float mFontSize;
+    float mLetterSpacing;
+    float mLineSpace;
+    float mScale;
+};
+
+bool Typesetter::sWarned = false;
+
+/**
+ * Width of characters [begin, end), ignoring trailing spaces and the kerning into the first character
+ */
+float
+measureRange(const std::vector<Character>& characters, size_t begin, size_t end) {
+    while (end > begin && isSpace(characters[end - 1].codepoint))
+        end--;
+
+    float width = 0;
+    for (auto i = begin; i < end; i++)
+        width += characters[i].advance + (i > begin ? characters[i].kerning : 0);
+    return width;
+}
+
+std::vector<Line>
+breakLines(const std::vector<Character>& characters, float maxWidth) {
+    std::vector<Line> lines;
+    size_t lineStart = 0;
+    size_t lastBreak = 0;
+    float lineWidth = 0;
+
+    for (size_t i = 0; i < characters.size(); i++) {
+        auto codepoint = characters[i].codepoint;
+        if (codepoint == '\n') {
+            lines.push_back({lineStart, i + 1, measureRange(characters, lineStart, i)});
+            lineStart = lastBreak = i + 1;
+            lineWidth = 0;
+            continue;
+        }
+
+        auto width = characters[i].advance + (i > lineStart ? characters[i].kerning : 0);
+        if (!isSpace(codepoint) && i > lineStart && lineWidth + width > maxWidth) {
+            auto lineEnd = lastBreak > lineStart ? lastBreak : i;
+            lines.push_back({lineStart, lineEnd, measureRange(characters, lineStart, lineEnd)});
+            lineStart = lastBreak = lineEnd;
+            lineWidth = measureRange(characters, lineStart, i);
+            width = characters[i].advance + (i > lineStart ? characters[i].kerning : 0);
+        }
+
+        lineWidth += width;
+        if (isBreakAfter(codepoint))
+            lastBreak = i + 1;
+    }
+
+    if (lineStart < characters.size())
+        lines.push_back({lineStart, characters.size(), measureRange(characters, lineStart, characters.size())});
+
+    return lines;
+}
+
+/**
+ * Shorten the last visible line so it ends with an ellipsis. Like the DOM measurement, the last
+ * word is replaced first and single long words are cut until the ellipsis fits.
+ * @return End of the kept characters
+ */
+size_t
+ellipsize(const std::vector<Character>& characters, const Line& line, float maxWidth, float ellipsisWidth) {
+    auto end = line.end;
+    while (end > line.begin && isSpace(characters[end - 1].codepoint))
+        end--;
+
+    for (auto i = end; i > line.begin + 1; i--) {
+        if (isSpace(characters[i - 1].codepoint)) {
+            end = i - 1;
+            break;
+        }
+    }
+
+    while (end > line.begin && measureRange(characters, line.begin, end) + ellipsisWidth > maxWidth)
+        end--;
+
+    while (end > line.begin && isSpace(characters[end - 1].codepoint))
+        end--;
+
+    return end;
+}
+
+float
+resolveSize(float measured, float constraint, apl::MeasureMode mode) {
+    switch (mode) {
+        case apl::MeasureMode::Exactly:
+            return constraint;
+        case apl::MeasureMode::AtMost:
+            return std::isnan(constraint) ? measured : std::min(measured, constraint);
+        default:
+            return measured;
+    }
+}
+
+} // namespace
+
+apl::sg::TextLayoutPtr
+NativeTextMeasurement::layout(apl::Component *component,
+                              const apl::sg::TextChunkPtr& chunk,
+                              const apl::sg::TextPropertiesPtr& textProperties,
+                              float width,
+                              apl::MeasureMode widthMode,
+                              float height,
+                              apl::MeasureMode heightMode) {
+    Typesetter typesetter(textProperties);
+    auto plainText = chunk ? chunk->styledText().getText() : std::string();
+    auto characters = decodeUtf8(plainText);
+    typesetter.shape(characters);
+
+    bool unbounded = widthMode == apl::MeasureMode::Undefined || std::isnan(width);
+    float maxWidth = unbounded ? std::numeric_limits<float>::infinity() : width;
+    auto lines = breakLines(characters, maxWidth);
+
+    auto lineSpace = typesetter.lineSpace();
+    size_t maxLines = textProperties->maxLines() > 0 ? textProperties->maxLines() : lines.size();
+    if (heightMode != apl::MeasureMode::Undefined && !std::isnan(height) && lineSpace > 0)
+        maxLines = std::min(maxLines, static_cast<size_t>(std::max(1.0f, std::floor(height / lineSpace))));
+
+    bool isTruncated = lines.size() > maxLines;
+    size_t ellipsisEnd = 0;
+    if (isTruncated) {
+        lines.resize(maxLines);
+        auto ellipsisWidth = typesetter.advance(ELLIPSIS);
+        auto& last = lines.back();
+        ellipsisEnd = ellipsize(characters, last, maxWidth, ellipsisWidth);
+        last.width = measureRange(characters, last.begin, ellipsisEnd) + ellipsisWidth;
+    }
+
+    float contentWidth = 0;
+    for (const auto& line : lines)
+        contentWidth = std::max(contentWidth, line.width);
+
+    float measuredWidth = resolveSize(contentWidth, width, widthMode);
+    float measuredHeight = resolveSize(std::max<size_t>(lines.size(), 1) * lineSpace, height, heightMode);
+
+    auto textAlign = textProperties->textAlign();
+    std::string laidOutText;
+    std::vector<std::string> textsByLine;
+    std::vector<apl::Rect> rectsByLine;
+    textsByLine.reserve(lines.size());
+    rectsByLine.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        const auto& line = lines[i];
+        bool ellipsized = isTruncated && i == lines.size() - 1;
+        auto end = ellipsized ? ellipsisEnd : line.end;
+        auto beginOffset = line.begin < characters.size() ? characters[line.begin].offset : plainText.size();
+        auto endOffset = end < characters.size() ? characters[end].offset : plainText.size();
+        auto lineText = plainText.substr(beginOffset, endOffset - beginOffset);
+        if (ellipsized)
+            lineText += ELLIPSIS_UTF8;
+
+        float x = 0;
+        if (textAlign == apl::kTextAlignCenter)
+            x = (measuredWidth - line.width) / 2;
+        else if (textAlign == apl::kTextAlignRight)
+            x = measuredWidth - line.width;
+
+        laidOutText += lineText;
+        textsByLine.emplace_back(std::move(lineText));
+        rectsByLine.emplace_back(x, i * lineSpace, line.width, lineSpace);
+    }
+
+    return std::make_shared<WasmTextLayout>(measuredWidth,
+                                            measuredHeight,
+                                            typesetter.baseline(),
+                                            lines.size(),
+                                            plainText,
+                                            isTruncated ? laidOutText : plainText,
+                                            isTruncated,
+                                            textsByLine,
+                                            rectsByLine);
+}
+
+apl::sg::EditTextBoxPtr
+NativeTextMeasurement::box(apl::Component *component,
+                           int size,
+                           const apl::sg::TextPropertiesPtr& textProperties,
+                           float width,
+                           apl::MeasureMode widthMode,
+                           float height,
+                           apl::MeasureMode heightMode) {
+    Typesetter typesetter(textProperties);
+
+    // Room for size of the widest common character
+    float contentWidth = std::max(size, 1) * typesetter.advance('M');
+    float measuredWidth = resolveSize(contentWidth, width, widthMode);
+    float measuredHeight = resolveSize(typesetter.lineSpace(), height, heightMode);
+
+    return std::make_shared<WasmEditTextBox>(measuredWidth, measuredHeight, typesetter.baseline());
+}
+
+} // namespace wasm
+} // namespace apl
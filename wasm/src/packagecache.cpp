@@ -0,0 +1,378 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/packagecache.h"
+#include "wasm/packagemanager.h"
+#include "wasm/jsonsnapshot.h"
+#include "apl/content/jsondata.h"
+#include "apl/utils/log.h"
+#include <algorithm>
+#include <list>
+#include <set>
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const char KEY_SEPARATOR = '|';
+
+std::string
+makeKey(const std::string& name, const std::string& version, const std::string& domain, const std::string& source) {
+    auto key = name + ":" + version;
+    if (!domain.empty() || !source.empty())
+        key += KEY_SEPARATOR + domain + KEY_SEPARATOR + source;
+    return key;
+}
+
+struct CacheEntry {
+    std::string reference;
+    std::shared_ptr<rapidjson::Document> document;
+    size_t bytes;
+};
+
+struct Waiter {
+    PackageManager* manager;
+    PackageRequestPtr request;
+};
+
+struct Fetch {
+    PackageManager* owner;
+    std::vector<Waiter> waiters;
+};
+
+struct CacheState {
+    std::list<CacheEntry> entries;
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> index;
+    std::unordered_map<std::string, Fetch> inFlight;
+    std::unordered_map<std::string, std::vector<PackageImport>> graph;
+    size_t bytes = 0;
+    size_t byteBudget = PackageCache::DEFAULT_BYTE_BUDGET;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+CacheState&
+cacheState() {
+    static CacheState state;
+    return state;
+}
+
+void
+trim(CacheState& state) {
+    while (state.bytes > state.byteBudget && !state.entries.empty()) {
+        state.bytes -= state.entries.back().bytes;
+        state.index.erase(state.entries.back().reference);
+        state.entries.pop_back();
+    }
+}
+
+void
+put(CacheState& state, const std::string& reference, const std::shared_ptr<rapidjson::Document>& document, size_t bytes) {
+    auto it = state.index.find(reference);
+    if (it != state.index.end()) {
+        state.bytes -= it->second->bytes;
+        state.entries.erase(it->second);
+        state.index.erase(it);
+    }
+
+    // A package larger than the whole budget would only evict everything else
+    if (bytes > state.byteBudget)
+        return;
+
+    state.entries.push_front({reference, document, bytes});
+    state.index.emplace(reference, state.entries.begin());
+    state.bytes += bytes;
+    trim(state);
+}
+
+void
+addImports(CacheState& state, const std::string& reference, std::vector<PackageImport>&& imports) {
+    if (state.graph.size() >= PackageCache::MAX_GRAPH_ENTRIES && state.graph.find(reference) == state.graph.end())
+        return;
+    state.graph[reference] = std::move(imports);
+}
+
+std::string
+getString(const rapidjson::Value& value, const char* name) {
+    auto it = value.FindMember(name);
+    return it != value.MemberEnd() && it->value.IsString()
+        ? std::string(it->value.GetString(), it->value.GetStringLength())
+        : std::string();
+}
+
+void
+recordImports(CacheState& state, const std::string& reference, const rapidjson::Document& document) {
+    std::vector<PackageImport> imports;
+    if (document.IsObject()) {
+        auto list = document.FindMember("import");
+        if (list != document.MemberEnd() && list->value.IsArray()) {
+            for (const auto& entry : list->value.GetArray()) {
+                if (!entry.IsObject())
+                    continue;
+                PackageImport packageImport{getString(entry, "name"), getString(entry, "version"),
+                                            getString(entry, "source"), getString(entry, "domain")};
+                if (!packageImport.name.empty())
+                    imports.emplace_back(std::move(packageImport));
+            }
+        }
+    }
+    addImports(state, reference, std::move(imports));
+}
+
+void
+resolve(CacheState& state, const std::string& reference, const std::shared_ptr<rapidjson::Document>& document,
+        size_t bytes, const std::vector<Waiter>& waiters) {
+    recordImports(state, reference, *document);
+    put(state, reference, document, bytes);
+    for (const auto& waiter : waiters)
+        waiter.request->succeed(SharedJsonData(document));
+}
+
+std::vector<Waiter>
+takeWaiters(CacheState& state, const std::string& reference) {
+    std::vector<Waiter> waiters;
+    auto it = state.inFlight.find(reference);
+    if (it != state.inFlight.end()) {
+        waiters.swap(it->second.waiters);
+        state.inFlight.erase(it);
+    }
+    return waiters;
+}
+
+} // namespace
+
+std::string
+PackageCache::key(const ImportRequest& request) {
+    const auto& ref = request.reference();
+    return makeKey(ref.name(), ref.version(), ref.domain(), request.source());
+}
+
+std::string
+PackageCache::key(const PackageImport& packageImport) {
+    return makeKey(packageImport.name, packageImport.version, packageImport.domain, packageImport.source);
+}
+
+std::string
+PackageCache::reference(const std::string& key) {
+    return key.substr(0, key.find(KEY_SEPARATOR));
+}
+
+bool
+PackageCache::contains(const std::string& key) {
+    auto& index = cacheState().index;
+    return index.find(key) != index.end();
+}
+
+std::shared_ptr<rapidjson::Document>
+PackageCache::get(const std::string& reference) {
+    auto& state = cacheState();
+    auto it = state.index.find(reference);
+    if (it == state.index.end()) {
+        state.misses++;
+        return nullptr;
+    }
+
+    state.hits++;
+    state.entries.splice(state.entries.begin(), state.entries, it->second);
+    return it->second->document;
+}
+
+bool
+PackageCache::wait(const std::string& reference, PackageManager* manager, const PackageRequestPtr& request) {
+    auto& inFlight = cacheState().inFlight;
+    auto it = inFlight.find(reference);
+    if (it != inFlight.end()) {
+        it->second.waiters.push_back({manager, request});
+        return false;
+    }
+
+    inFlight.emplace(reference, Fetch{manager, {{manager, request}}});
+    return true;
+}
+
+bool
+PackageCache::succeed(const std::string& reference, const std::string& packageJson) {
+    auto& state = cacheState();
+    auto waiters = takeWaiters(state, reference);
+    if (waiters.empty() && state.index.find(reference) != state.index.end())
+        return false;
+
+    auto document = std::make_shared<rapidjson::Document>();
+    document->Parse(packageJson.c_str(), packageJson.size());
+    if (document->HasParseError()) {
+        LOG(LogLevel::ERROR) << "Unable to parse package " << reference;
+        for (const auto& waiter : waiters)
+            waiter.request->fail("Unable to parse package", -1);
+        return !waiters.empty();
+    }
+
+    resolve(state, reference, document, packageJson.size(), waiters);
+    return !waiters.empty();
+}
+
+bool
+PackageCache::succeedWithSnapshot(const std::string& reference, emscripten::val snapshot) {
+    auto& state = cacheState();
+    auto size = snapshot["length"].as<size_t>();
+    // Snapshots record the "name:version" of their package, without where it comes from
+    auto document = JsonSnapshot::decode(emscripten::convertJSArrayToNumberVector<uint8_t>(snapshot),
+                                         PackageCache::reference(reference));
+    if (!document) {
+        LOG(LogLevel::WARN) << "Rejected the snapshot of package " << reference;
+        return false;
+    }
+
+    auto waiters = takeWaiters(state, reference);
+    resolve(state, reference, document, size, waiters);
+    return true;
+}
+
+bool
+PackageCache::fail(const std::string& reference, const std::string& msg, int code) {
+    auto waiters = takeWaiters(cacheState(), reference);
+    for (const auto& waiter : waiters)
+        waiter.request->fail(msg, code);
+    return !waiters.empty();
+}
+
+void
+PackageCache::release(PackageManager* manager) {
+    auto& inFlight = cacheState().inFlight;
+    std::vector<Waiter> refetch;
+    for (auto it = inFlight.begin(); it != inFlight.end();) {
+        auto& fetch = it->second;
+        auto& waiters = fetch.waiters;
+        waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                     [manager](const Waiter& waiter) { return waiter.manager == manager; }),
+                      waiters.end());
+        if (waiters.empty()) {
+            it = inFlight.erase(it);
+            continue;
+        }
+        if (fetch.owner == manager) {
+            fetch.owner = waiters.front().manager;
+            refetch.push_back(waiters.front());
+        }
+        ++it;
+    }
+
+    // The viewhost of the released manager will not answer, ask the next one
+    for (const auto& waiter : refetch)
+        waiter.manager->fetch(waiter.request);
+}
+
+std::vector<PackageImport>
+PackageCache::transitiveImports(const std::vector<std::string>& roots) {
+    auto& state = cacheState();
+    std::set<std::string> seen(roots.begin(), roots.end());
+    std::vector<std::string> queue(roots.begin(), roots.end());
+    std::vector<PackageImport> result;
+    for (size_t i = 0; i < queue.size(); i++) {
+        auto it = state.graph.find(queue[i]);
+        if (it == state.graph.end())
+            continue;
+        for (const auto& packageImport : it->second) {
+            auto ref = key(packageImport);
+            if (!seen.emplace(ref).second)
+                continue;
+            queue.push_back(ref);
+            if (state.index.find(ref) == state.index.end() && state.inFlight.find(ref) == state.inFlight.end())
+                result.push_back(packageImport);
+        }
+    }
+    return result;
+}
+
+void
+PackageCache::addImportGraph(emscripten::val graph) {
+    if (graph.isUndefined() || graph.isNull())
+        return;
+
+    auto& state = cacheState();
+    auto references = emscripten::val::global("Object").call<emscripten::val>("keys", graph);
+    auto count = references["length"].as<int>();
+    for (int i = 0; i < count; i++) {
+        auto ref = references[i].as<std::string>();
+        auto entries = graph[ref];
+        auto entryCount = entries["length"].as<int>();
+        std::vector<PackageImport> imports;
+        for (int j = 0; j < entryCount; j++) {
+            auto entry = entries[j];
+            if (!entry["name"].isString() || !entry["version"].isString())
+                continue;
+            imports.push_back({entry["name"].as<std::string>(), entry["version"].as<std::string>(),
+                               entry["source"].isString() ? entry["source"].as<std::string>() : std::string(),
+                               entry["domain"].isString() ? entry["domain"].as<std::string>() : std::string()});
+        }
+        addImports(state, ref, std::move(imports));
+    }
+}
+
+emscripten::val
+PackageCache::getImportGraph() {
+    auto graph = emscripten::val::object();
+    for (const auto& entry : cacheState().graph) {
+        auto imports = emscripten::val::array();
+        for (size_t i = 0; i < entry.second.size(); i++) {
+            const auto& packageImport = entry.second[i];
+            auto value = emscripten::val::object();
+            value.set("name", packageImport.name);
+            value.set("version", packageImport.version);
+            if (!packageImport.source.empty())
+                value.set("source", packageImport.source);
+            if (!packageImport.domain.empty())
+                value.set("domain", packageImport.domain);
+            imports.set(i, value);
+        }
+        graph.set(entry.first, imports);
+    }
+    return graph;
+}
+
+void
+PackageCache::clear() {
+    auto& state = cacheState();
+    state.entries.clear();
+    state.index.clear();
+    state.bytes = 0;
+}
+
+void
+PackageCache::setByteBudget(size_t byteBudget) {
+    auto& state = cacheState();
+    state.byteBudget = byteBudget;
+    trim(state);
+}
+
+emscripten::val
+PackageCache::getStats() {
+    auto& state = cacheState();
+    auto stats = emscripten::val::object();
+    stats.set("hits", state.hits);
+    stats.set("misses", state.misses);
+    stats.set("entries", state.entries.size());
+    stats.set("bytes", state.bytes);
+    stats.set("byteBudget", state.byteBudget);
+    stats.set("inFlight", state.inFlight.size());
+    return stats;
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_package_cache) {
+
+    emscripten::class_<PackageCache>("PackageCache")
+        .class_function("getKey", static_cast<std::string (*)(const ImportRequest&)>(&PackageCache::key))
+        .class_function("addPackage", &PackageCache::succeed)
+        .class_function("addPackageSnapshot", &PackageCache::succeedWithSnapshot)
+        .class_function("addImportGraph", &PackageCache::addImportGraph)
+        .class_function("getImportGraph", &PackageCache::getImportGraph)
+        .class_function("clear", &PackageCache::clear)
+        .class_function("setByteBudget", &PackageCache::setByteBudget)
+        .class_function("getStats", &PackageCache::getStats);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -4,6 +4,7 @@
  */
 
 #include "wasm/packagemanager.h"
+#include "wasm/packagecache.h"
 #include "wasm/embindutils.h"
 #include "apl/content/jsondata.h"
 #include "apl/utils/log.h"
@@ -21,48 +22,49 @@ PackageManager::PackageManager(emscripten::val importPackageCallback)
     : mImportPackageCallback(importPackageCallback)
 {}
 
+PackageManager::~PackageManager() {
+    PackageCache::release(this);
+}
+
 void
 PackageManager::destroy() {
-    mPendingPackageRequests.clear();
+    PackageCache::release(this);
 }
 
 // Implements apl::PackageManager::importPackage
 void 
 PackageManager::loadPackage(const PackageRequestPtr& packageRequest) {
-    auto request = packageRequest->request();
-    std::string reference = request.reference().toString();
+    auto reference = PackageCache::key(packageRequest->request());
 
-    // Store ImportRequest + callbacks at C++ level
-    mPendingPackageRequests[reference] = packageRequest;
+    auto cached = PackageCache::get(reference);
+    if (cached) {
+        packageRequest->succeed(SharedJsonData(cached));
+        return;
+    }
 
-    // Pass ImportRequest to JS
-    mImportPackageCallback(emscripten::val(request));
+    // Requests for a package already being fetched wait for that fetch
+    if (PackageCache::wait(reference, this, packageRequest))
+        fetch(packageRequest);
 }
 
 void
-PackageManager::importPackageSucceeded(const std::string& reference, const std::string& packageJson) {
-    auto pendingRequest = mPendingPackageRequests.find(reference);
-    if (pendingRequest == mPendingPackageRequests.end()) {
-        LOG(LogLevel::ERROR) << "Import request not found: " + reference;
-        return;
-    }
+PackageManager::fetch(const PackageRequestPtr& packageRequest) {
+    // Pass ImportRequest to JS
+    mImportPackageCallback(emscripten::val(packageRequest->request()));
+}
 
-    auto packageRequest = pendingRequest->second;
-    packageRequest->succeed(SharedJsonData(packageJson));
-    mPendingPackageRequests.erase(reference);
+void
+PackageManager::importPackageSucceeded(const ImportRequest& request, const std::string& packageJson) {
+    // Nothing waits on a package that a prefetch completed first, its own download is a no-op
+    PackageCache::succeed(PackageCache::key(request), packageJson);
 }
 
 void
-PackageManager::importPackageFailed(const std::string& reference, const std::string& msg, int code) {
-    auto pendingRequest = mPendingPackageRequests.find(reference);
-    if (pendingRequest == mPendingPackageRequests.end()) {
+PackageManager::importPackageFailed(const ImportRequest& request, const std::string& msg, int code) {
+    auto reference = PackageCache::key(request);
+    if (!PackageCache::fail(reference, msg, code) && !PackageCache::contains(reference)) {
         LOG(LogLevel::ERROR) << "Import request not found: " + reference;
-        return;
     }
-
-    auto packageRequest = pendingRequest->second;
-    packageRequest->fail(msg, code);
-    mPendingPackageRequests.erase(reference);
 }
 
 
@@ -0,0 +1,163 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/propertyconversion.h"
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+struct KnownProperty {
+    PropertyKey key;
+    ConversionKind kind;
+};
+
+// Properties with a fixed type, so the first render of a component skips classification for them
+constexpr KnownProperty KNOWN_PROPERTIES[] = {
+    {kPropertyAccessibilityLabel, kConversionString},
+    {kPropertyAlign, kConversionNumber},
+    {kPropertyBorderColor, kConversionColor},
+    {kPropertyBorderRadii, kConversionRadii},
+    {kPropertyBounds, kConversionRect},
+    {kPropertyColor, kConversionColor},
+    {kPropertyColorKaraokeTarget, kConversionColor},
+    {kPropertyColorNonKaraoke, kConversionColor},
+    {kPropertyDisabled, kConversionBoolean},
+    {kPropertyDisplay, kConversionNumber},
+    {kPropertyDrawnBorderWidth, kConversionAbsoluteDimension},
+    {kPropertyFilters, kConversionArray},
+    {kPropertyFontFamily, kConversionString},
+    {kPropertyFontSize, kConversionAbsoluteDimension},
+    {kPropertyFontStyle, kConversionNumber},
+    {kPropertyGestures, kConversionArray},
+    {kPropertyGraphic, kConversionGraphic},
+    {kPropertyHighlightColor, kConversionColor},
+    {kPropertyHintColor, kConversionColor},
+    {kPropertyInnerBounds, kConversionRect},
+    {kPropertyLang, kConversionString},
+    {kPropertyLayoutDirection, kConversionNumber},
+    {kPropertyMediaBounds, kConversionRect},
+    {kPropertyOnDown, kConversionArray},
+    {kPropertyOnPress, kConversionArray},
+    {kPropertyOnUp, kConversionArray},
+    {kPropertyOpacity, kConversionNumber},
+    {kPropertyOverlayColor, kConversionColor},
+    {kPropertyRole, kConversionNumber},
+    {kPropertyScrollDirection, kConversionNumber},
+    {kPropertyShadowColor, kConversionColor},
+    {kPropertyShadowHorizontalOffset, kConversionAbsoluteDimension},
+    {kPropertyShadowRadius, kConversionAbsoluteDimension},
+    {kPropertyShadowVerticalOffset, kConversionAbsoluteDimension},
+    {kPropertyTextAlign, kConversionNumber},
+    {kPropertyTextAlignVertical, kConversionNumber},
+    {kPropertyTransform, kConversionTransform2D},
+    {kPropertyUser, kConversionMap},
+};
+
+} // namespace
+
+ConversionKind
+PropertyConversion::classify(const Object& value) {
+    if (value.isNumber())
+        return kConversionNumber;
+    else if (value.isBoolean())
+        return kConversionBoolean;
+    else if (value.isString())
+        return kConversionString;
+    else if (value.is<Color>())
+        return kConversionColor;
+    else if (value.isAbsoluteDimension())
+        return kConversionAbsoluteDimension;
+    else if (value.is<Filter>())
+        return kConversionFilter;
+    else if (value.is<Radii>())
+        return kConversionRadii;
+    else if (value.is<Rect>())
+        return kConversionRect;
+    else if (value.is<Gradient>())
+        return kConversionGradient;
+    else if (value.is<GraphicFilter>())
+        return kConversionGraphicFilter;
+    else if (value.is<GraphicPattern>())
+        return kConversionGraphicPattern;
+    else if (value.is<MediaSource>())
+        return kConversionMediaSource;
+    else if (value.isMap())
+        return kConversionMap;
+    else if (value.isArray())
+        return kConversionArray;
+    else if (value.is<StyledText>())
+        return kConversionStyledText;
+    else if (value.is<Graphic>())
+        return kConversionGraphic;
+    else if (value.is<Transform2D>())
+        return kConversionTransform2D;
+    else if (value.is<URLRequest>())
+        return kConversionURLRequest;
+
+    return kConversionUndefined;
+}
+
+bool
+PropertyConversion::matches(const Object& value, ConversionKind kind) {
+    switch (kind) {
+        case kConversionNumber: return value.isNumber();
+        case kConversionBoolean: return value.isBoolean();
+        case kConversionString: return value.isString();
+        case kConversionColor: return value.is<Color>();
+        case kConversionAbsoluteDimension: return value.isAbsoluteDimension();
+        case kConversionFilter: return value.is<Filter>();
+        case kConversionRadii: return value.is<Radii>();
+        case kConversionRect: return value.is<Rect>();
+        case kConversionGradient: return value.is<Gradient>();
+        case kConversionGraphicFilter: return value.is<GraphicFilter>();
+        case kConversionGraphicPattern: return value.is<GraphicPattern>();
+        case kConversionMediaSource: return value.is<MediaSource>();
+        case kConversionMap: return value.isMap();
+        case kConversionArray: return value.isArray();
+        case kConversionStyledText: return value.is<StyledText>();
+        case kConversionGraphic: return value.is<Graphic>();
+        case kConversionTransform2D: return value.is<Transform2D>();
+        case kConversionURLRequest: return value.is<URLRequest>();
+        default: return false;
+    }
+}
+
+ConversionKind
+PropertyConversion::lookup(PropertyKey key, const Object& value) {
+    auto index = static_cast<size_t>(key);
+    auto& kinds = table();
+    if (index >= kinds.size())
+        kinds.resize(index + 1, kConversionUnknown);
+
+    auto& kind = kinds[index];
+    if (kind != kConversionUnknown && matches(value, kind))
+        return kind;
+
+    // Null values carry no type information, so they leave the table untouched
+    auto resolved = classify(value);
+    if (resolved != kConversionUndefined)
+        kind = resolved;
+    return resolved;
+}
+
+std::vector<ConversionKind>&
+PropertyConversion::table() {
+    static std::vector<ConversionKind> kinds = [] {
+        std::vector<ConversionKind> result;
+        for (const auto& property : KNOWN_PROPERTIES) {
+            auto index = static_cast<size_t>(property.key);
+            if (index >= result.size())
+                result.resize(index + 1, kConversionUnknown);
+            result[index] = property.kind;
+        }
+        return result;
+    }();
+    return kinds;
+}
+
+} // namespace wasm
+} // namespace apl
@@ -4,21 +4,49 @@
  */
 
 #include "wasm/rootconfig.h"
+#include "apl/dynamicdata.h"
 #include "wasm/embindutils.h"
 #include "wasm/localemethods.h"
 #include "wasm/audioplayerfactory.h"
 #include "wasm/mediaplayerfactory.h"
 #include "wasm/packagemanager.h"
 #include "wasm/documentmanager.h"
+#include "wasm/nativetextmeasurement.h"
+#include "utils/jsparser.h"
+#include <map>
 
 // Default font
 static const char DEFAULT_FONT[] = "amazon-ember-display";
 
+// Text measurement modes
+static const char TEXT_MEASUREMENT_NATIVE[] = "native";
+
+static const char DYNAMIC_INDEX_LIST[] = "dynamicIndexList";
+
 namespace apl {
 namespace wasm {
 
 namespace internal {
 
+namespace {
+
+struct IndexListEntry {
+    std::weak_ptr<RootConfig> rootConfig;
+    DynamicIndexListConfiguration configuration;
+};
+
+/**
+ * dynamicIndexList configurations by root config. Core only stores built providers on a root
+ * config, so the configuration is kept here until the contexts that need one are created.
+ */
+std::map<const RootConfig*, IndexListEntry>&
+indexListConfigurations() {
+    static std::map<const RootConfig*, IndexListEntry> sConfigurations;
+    return sConfigurations;
+}
+
+} // namespace
+
 RootConfigPtr
 RootConfigMethods::create(emscripten::val environment) {
     // Create root config from options
@@ -150,6 +178,56 @@ RootConfigMethods::documentManager(RootConfigPtr& rootConfig, emscripten::val do
     return rootConfig;
 }
 
+RootConfigPtr&
+RootConfigMethods::textMeasurementMode(RootConfigPtr& rootConfig, const std::string& mode) {
+    // DOM measurement is installed by Context.create from the viewhost callbacks; native
+    // measurement is kept as is and takes precedence over them.
+    bool isNative = std::dynamic_pointer_cast<NativeTextMeasurement>(rootConfig->getMeasure()) != nullptr;
+    if (mode == TEXT_MEASUREMENT_NATIVE) {
+        if (!isNative) {
+            rootConfig->measure(std::make_shared<NativeTextMeasurement>());
+        }
+    } else if (isNative) {
+        rootConfig->measure(apl::sg::TextMeasurement::instance());
+    }
+    return rootConfig;
+}
+
+RootConfigPtr&
+RootConfigMethods::dynamicIndexListConfiguration(RootConfigPtr& rootConfig, emscripten::val configuration) {
+    DynamicIndexListConfiguration defaults;
+    DynamicIndexListConfiguration listConfiguration;
+    listConfiguration.setType(DYNAMIC_INDEX_LIST)
+        .setCacheChunkSize(jsparser::getOptionalValue(configuration, "cacheChunkSize", defaults.cacheChunkSize))
+        .setListUpdateBufferSize(jsparser::getOptionalValue(configuration, "listUpdateBufferSize",
+                                                            defaults.listUpdateBufferSize))
+        .setFetchRetries(jsparser::getOptionalValue(configuration, "fetchRetries", defaults.fetchRetries))
+        .setFetchTimeout(jsparser::getOptionalValue(configuration, "fetchTimeout", defaults.fetchTimeout))
+        .setCacheExpiryTimeout(jsparser::getOptionalValue(configuration, "cacheExpiryTimeout",
+                                                          defaults.cacheExpiryTimeout));
+
+    // Released root configs are dropped first, their addresses may be reused
+    auto& configurations = indexListConfigurations();
+    for (auto it = configurations.begin(); it != configurations.end();) {
+        if (it->second.rootConfig.expired())
+            it = configurations.erase(it);
+        else
+            ++it;
+    }
+
+    configurations[rootConfig.get()] = {rootConfig, listConfiguration};
+    return rootConfig;
+}
+
+DataSourceProviderPtr
+RootConfigMethods::createDynamicIndexListProvider(const RootConfigPtr& rootConfig) {
+    auto& configurations = indexListConfigurations();
+    auto it = configurations.find(rootConfig.get());
+    if (it == configurations.end() || it->second.rootConfig.lock() != rootConfig)
+        return nullptr;
+    return std::make_shared<DynamicIndexListDataSourceProvider>(it->second.configuration);
+}
+
 } // namespace internal
 
 EMSCRIPTEN_BINDINGS(apl_wasm_rootconfig) {
@@ -169,7 +247,9 @@ EMSCRIPTEN_BINDINGS(apl_wasm_rootconfig) {
         .function("audioPlayerFactory", &internal::RootConfigMethods::audioPlayerFactory)
         .function("mediaPlayerFactory", &internal::RootConfigMethods::mediaPlayerFactory)
         .function("packageManager", &internal::RootConfigMethods::packageManager)
-        .function("documentManager", &internal::RootConfigMethods::documentManager);
+        .function("documentManager", &internal::RootConfigMethods::documentManager)
+        .function("textMeasurementMode", &internal::RootConfigMethods::textMeasurementMode)
+        .function("dynamicIndexListConfiguration", &internal::RootConfigMethods::dynamicIndexListConfiguration);
 }
 
 } // namespace wasm
@@ -0,0 +1,174 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/textlayoutcache.h"
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+inline void
+hashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // namespace
+
+bool
+TextLayoutCache::Key::operator==(const Key& other) const {
+    return isBox == other.isBox &&
+           size == other.size &&
+           propertiesHash == other.propertiesHash &&
+           width == other.width &&
+           widthMode == other.widthMode &&
+           height == other.height &&
+           heightMode == other.heightMode &&
+           text == other.text;
+}
+
+size_t
+TextLayoutCache::KeyHash::operator()(const Key& key) const {
+    size_t seed = std::hash<std::string>()(key.text);
+    hashCombine(seed, std::hash<bool>()(key.isBox));
+    hashCombine(seed, std::hash<int>()(key.size));
+    hashCombine(seed, key.propertiesHash);
+    hashCombine(seed, std::hash<float>()(key.width));
+    hashCombine(seed, std::hash<int>()(key.widthMode));
+    hashCombine(seed, std::hash<float>()(key.height));
+    hashCombine(seed, std::hash<int>()(key.heightMode));
+    return seed;
+}
+
+TextLayoutCache::TextLayoutCache(size_t byteBudget)
+    : mByteBudget(byteBudget)
+{}
+
+apl::sg::TextLayoutPtr
+TextLayoutCache::findLayout(const std::string& text,
+                            const apl::sg::TextPropertiesPtr& textProperties,
+                            float width,
+                            apl::MeasureMode widthMode,
+                            float height,
+                            apl::MeasureMode heightMode) {
+    auto entry = find(makeKey(false, text, 0, textProperties, width, widthMode, height, heightMode));
+    return entry ? entry->layout : nullptr;
+}
+
+void
+TextLayoutCache::putLayout(const std::string& text,
+                           const apl::sg::TextPropertiesPtr& textProperties,
+                           float width,
+                           apl::MeasureMode widthMode,
+                           float height,
+                           apl::MeasureMode heightMode,
+                           const apl::sg::TextLayoutPtr& layout,
+                           size_t layoutBytes) {
+    auto key = makeKey(false, text, 0, textProperties, width, widthMode, height, heightMode);
+    auto bytes = sizeof(Entry) + key.text.size() + layoutBytes;
+    put({std::move(key), layout, nullptr, bytes});
+}
+
+apl::sg::EditTextBoxPtr
+TextLayoutCache::findBox(int size,
+                         const apl::sg::TextPropertiesPtr& textProperties,
+                         float width,
+                         apl::MeasureMode widthMode,
+                         float height,
+                         apl::MeasureMode heightMode) {
+    auto entry = find(makeKey(true, std::string(), size, textProperties, width, widthMode, height, heightMode));
+    return entry ? entry->box : nullptr;
+}
+
+void
+TextLayoutCache::putBox(int size,
+                        const apl::sg::TextPropertiesPtr& textProperties,
+                        float width,
+                        apl::MeasureMode widthMode,
+                        float height,
+                        apl::MeasureMode heightMode,
+                        const apl::sg::EditTextBoxPtr& box) {
+    auto key = makeKey(true, std::string(), size, textProperties, width, widthMode, height, heightMode);
+    put({std::move(key), nullptr, box, sizeof(Entry) + sizeof(apl::sg::EditTextBox)});
+}
+
+void
+TextLayoutCache::clear() {
+    mIndex.clear();
+    mEntries.clear();
+    mBytes = 0;
+}
+
+void
+TextLayoutCache::setByteBudget(size_t byteBudget) {
+    mByteBudget = byteBudget;
+    evict();
+}
+
+TextLayoutCache::Key
+TextLayoutCache::makeKey(bool isBox, const std::string& text, int size,
+                         const apl::sg::TextPropertiesPtr& textProperties,
+                         float width, apl::MeasureMode widthMode,
+                         float height, apl::MeasureMode heightMode) {
+    // An undefined constraint carries no meaningful value (and may be NaN), so it must not split the key
+    return {
+        isBox,
+        text,
+        size,
+        textProperties ? textProperties->hash() : 0,
+        widthMode == apl::MeasureMode::Undefined ? 0 : width,
+        static_cast<int>(widthMode),
+        heightMode == apl::MeasureMode::Undefined ? 0 : height,
+        static_cast<int>(heightMode)
+    };
+}
+
+const TextLayoutCache::Entry*
+TextLayoutCache::find(const Key& key) {
+    if (mByteBudget == 0)
+        return nullptr;
+
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+        mMisses++;
+        return nullptr;
+    }
+
+    mHits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return &(*it->second);
+}
+
+void
+TextLayoutCache::put(Entry&& entry) {
+    if (entry.bytes > mByteBudget)
+        return;
+
+    auto it = mIndex.find(entry.key);
+    if (it != mIndex.end()) {
+        mBytes -= it->second->bytes;
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+    }
+
+    mBytes += entry.bytes;
+    mEntries.push_front(std::move(entry));
+    mIndex.emplace(mEntries.front().key, mEntries.begin());
+    evict();
+}
+
+void
+TextLayoutCache::evict() {
+    while (mBytes > mByteBudget && !mEntries.empty()) {
+        auto& last = mEntries.back();
+        mBytes -= last.bytes;
+        mIndex.erase(last.key);
+        mEntries.pop_back();
+        mEvictions++;
+    }
+}
+
+} // namespace wasm
+} // namespace apl
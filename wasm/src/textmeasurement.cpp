@@ -10,14 +10,17 @@
 #include "apl/apl.h"
 #include "apl/utils/log.h"
 #include <emscripten/bind.h>
+#include <cmath>
 
 namespace apl {
 namespace wasm {
 
 WasmTextMeasurement::WasmTextMeasurement(emscripten::val measureCallback,
-                                         WASMMetrics* wasmMetrics)
+                                         WASMMetrics* wasmMetrics,
+                                         emscripten::val measureBatchCallback)
     : apl::sg::TextMeasurement(),
       mMeasureCallback(measureCallback),
+      mMeasureBatchCallback(measureBatchCallback),
       mWasmMetrics(wasmMetrics)
 {}
 
@@ -29,10 +32,111 @@ WasmTextMeasurement::layout(apl::Component *component,
                             apl::MeasureMode widthMode,
                             float height,
                             apl::MeasureMode heightMode) {
-    auto layout = measureLayout(component, width, widthMode, height, heightMode);
+    const auto& text = chunk ? chunk->styledText().getRawText() : std::string();
+    auto cached = mCache.findLayout(text, textProperties, width, widthMode, height, heightMode);
+    if (cached)
+        return cached;
+
+    if (mBatching) {
+        mPending.push_back({component->shared_from_this(), text, 0, textProperties,
+                            width, widthMode, height, heightMode, false});
+        auto size = estimateSize(textProperties, width, widthMode, height, heightMode);
+        return std::make_shared<WasmTextLayout>(size.getWidth(), size.getHeight(), size.getHeight() * 0.5f,
+                                                1, std::string(), std::string(), false,
+                                                std::vector<std::string>(), std::vector<apl::Rect>());
+    }
+
+    size_t layoutBytes = 0;
+    auto result = createLayout(measureLayout(component, width, widthMode, height, heightMode), layoutBytes);
+    mCache.putLayout(text, textProperties, width, widthMode, height, heightMode, result, layoutBytes);
+    return result;
+}
+
+apl::sg::EditTextBoxPtr 
+WasmTextMeasurement::box(apl::Component *component,
+                         int size,
+                         const apl::sg::TextPropertiesPtr& textProperties,
+                         float width,
+                         apl::MeasureMode widthMode,
+                         float height,
+                         apl::MeasureMode heightMode) {
+    auto cached = mCache.findBox(size, textProperties, width, widthMode, height, heightMode);
+    if (cached)
+        return cached;
+
+    if (mBatching) {
+        mPending.push_back({component->shared_from_this(), std::string(), size, textProperties,
+                            width, widthMode, height, heightMode, true});
+        auto estimate = estimateSize(textProperties, width, widthMode, height, heightMode);
+        return std::make_shared<WasmEditTextBox>(estimate.getWidth(), estimate.getHeight(), estimate.getHeight() * 0.5f);
+    }
+
+    auto result = createBox(measureLayout(component, width, widthMode, height, heightMode));
+    mCache.putBox(size, textProperties, width, widthMode, height, heightMode, result);
+    return result;
+}
+
+void
+WasmTextMeasurement::setMetrics(WASMMetrics* wasmMetrics) {
+    mWasmMetrics = wasmMetrics;
+    mCache.clear();
+}
+
+void
+WasmTextMeasurement::beginBatch() {
+    mBatching = canBatch();
+    mPending.clear();
+}
 
-    width = mWasmMetrics->toCore(layout["width"].as<float>());
-    height = mWasmMetrics->toCore(layout["height"].as<float>());
+size_t
+WasmTextMeasurement::resolveBatch() {
+    mBatching = false;
+    if (mPending.empty())
+        return 0;
+
+    auto requests = emscripten::val::array();
+    for (const auto& pending : mPending) {
+        pending.component->setUserData(mWasmMetrics);
+        auto request = emscripten::val::object();
+        request.set("component", pending.component);
+        request.set("width", mWasmMetrics->toViewhost(pending.width));
+        request.set("widthMode", static_cast<int>(pending.widthMode));
+        request.set("height", mWasmMetrics->toViewhost(pending.height));
+        request.set("heightMode", static_cast<int>(pending.heightMode));
+        requests.call<void>("push", request);
+    }
+
+    auto results = mMeasureBatchCallback(requests);
+    auto count = mPending.size();
+    if (!results.isArray() || results["length"].as<size_t>() != count) {
+        LOG(LogLevel::ERROR) << "Batch text measurement returned an unexpected result, measuring on demand";
+        mPending.clear();
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const auto& pending = mPending[i];
+        if (pending.isBox) {
+            mCache.putBox(pending.size, pending.textProperties,
+                          pending.width, pending.widthMode, pending.height, pending.heightMode,
+                          createBox(results[i]));
+        } else {
+            size_t layoutBytes = 0;
+            auto layout = createLayout(results[i], layoutBytes);
+            mCache.putLayout(pending.text, pending.textProperties,
+                             pending.width, pending.widthMode, pending.height, pending.heightMode,
+                             layout, layoutBytes);
+        }
+    }
+
+    mPending.clear();
+    return count;
+}
+
+std::shared_ptr<WasmTextLayout>
+WasmTextMeasurement::createLayout(const emscripten::val& layout, size_t& layoutBytes) {
+    float width = mWasmMetrics->toCore(layout["width"].as<float>());
+    float height = mWasmMetrics->toCore(layout["height"].as<float>());
     float baseline = mWasmMetrics->toCore(layout["baseline"].as<float>());
     int lineCount = mWasmMetrics->toCore(layout["lineCount"].as<int>());
     std::string plainText = layout["plainText"].as<std::string>();
@@ -41,6 +145,11 @@ WasmTextMeasurement::layout(apl::Component *component,
     std::vector<std::string> textsByLine = convertToStringVector(layout["textsByLine"]);
     std::vector<apl::Rect> rectsByLine = convertToRectVector(layout["rectsByLine"]);
 
+    layoutBytes = sizeof(WasmTextLayout) + plainText.size() + laidOutText.size() +
+                  rectsByLine.size() * sizeof(apl::Rect);
+    for (const auto& line : textsByLine)
+        layoutBytes += sizeof(std::string) + line.size();
+
     return std::make_shared<WasmTextLayout>(width, 
                                             height,
                                             baseline,
@@ -52,23 +161,33 @@ WasmTextMeasurement::layout(apl::Component *component,
                                             rectsByLine);
 }
 
-apl::sg::EditTextBoxPtr 
-WasmTextMeasurement::box(apl::Component *component,
-                         int size,
-                         const apl::sg::TextPropertiesPtr& textProperties,
-                         float width,
-                         apl::MeasureMode widthMode,
-                         float height,
-                         apl::MeasureMode heightMode) {
-    auto layout = measureLayout(component, width, widthMode, height, heightMode);
-
-    width = mWasmMetrics->toCore(layout["width"].as<float>());
-    height = mWasmMetrics->toCore(layout["height"].as<float>());
+std::shared_ptr<WasmEditTextBox>
+WasmTextMeasurement::createBox(const emscripten::val& layout) {
+    float width = mWasmMetrics->toCore(layout["width"].as<float>());
+    float height = mWasmMetrics->toCore(layout["height"].as<float>());
     float baseline = mWasmMetrics->toCore(layout["baseline"].as<float>());
 
     return std::make_shared<WasmEditTextBox>(width, height, baseline);
 }
 
+apl::Size
+WasmTextMeasurement::estimateSize(const apl::sg::TextPropertiesPtr& textProperties,
+                                  float width,
+                                  apl::MeasureMode widthMode,
+                                  float height,
+                                  apl::MeasureMode heightMode) {
+    // Assume a single line filling the available width; the real size replaces this on the next pass
+    float lineSpace = textProperties ? textProperties->fontSize() * textProperties->lineHeight() : 0;
+    float estimatedWidth = widthMode == apl::MeasureMode::Undefined || std::isnan(width) ? 0 : width;
+    float estimatedHeight = lineSpace;
+    if (heightMode == apl::MeasureMode::Exactly)
+        estimatedHeight = height;
+    else if (heightMode == apl::MeasureMode::AtMost && !std::isnan(height))
+        estimatedHeight = std::min(lineSpace, height);
+
+    return {estimatedWidth, estimatedHeight};
+}
+
 emscripten::val
 WasmTextMeasurement::measureLayout(apl::Component *component,
                                    float width,
@@ -0,0 +1,193 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "wasm/visualcontextreporter.h"
+#include "wasm/jsonbridge.h"
+#include <unordered_map>
+
+namespace apl {
+namespace wasm {
+
+namespace {
+
+const char* CHILDREN = "children";
+
+rapidjson::Value
+toEntryValue(const std::string& uid, const std::string& parent, int index, const rapidjson::Value& node,
+             rapidjson::Document::AllocatorType& allocator) {
+    rapidjson::Value entry(rapidjson::kObjectType);
+    entry.AddMember("uid", rapidjson::Value(uid.c_str(), uid.size(), allocator), allocator);
+    entry.AddMember("parent", rapidjson::Value(parent.c_str(), parent.size(), allocator), allocator);
+    entry.AddMember("index", index, allocator);
+    entry.AddMember("node", rapidjson::Value(node, allocator), allocator);
+    return entry;
+}
+
+struct Generation {
+    std::weak_ptr<DocumentContext> context;
+    unsigned current = 0;
+    unsigned cleared = 0;    // Last generation cleared by the viewhost
+};
+
+std::unordered_map<const DocumentContext*, Generation>&
+generations() {
+    static std::unordered_map<const DocumentContext*, Generation> sGenerations;
+    return sGenerations;
+}
+
+/**
+ * Fold the dirty flag of core into the generation of the document.
+ */
+Generation&
+update(const DocumentContextPtr& context) {
+    auto& entries = generations();
+    auto it = entries.find(context.get());
+    if (it == entries.end() || it->second.context.lock() != context) {
+        // Released documents are dropped first, their addresses may be reused
+        for (auto entry = entries.begin(); entry != entries.end();) {
+            if (entry->second.context.expired())
+                entry = entries.erase(entry);
+            else
+                ++entry;
+        }
+        auto& generation = entries[context.get()];
+        generation = Generation();
+        generation.context = context;
+        it = entries.find(context.get());
+    }
+
+    auto& generation = it->second;
+    if (context->isVisualContextDirty()) {
+        context->clearVisualContextDirty();
+        generation.current++;
+    }
+    return generation;
+}
+
+} // namespace
+
+unsigned
+VisualContextReporter::generation(const DocumentContextPtr& context) {
+    return update(context).current;
+}
+
+bool
+VisualContextReporter::isDirty(const DocumentContextPtr& context) {
+    auto& generation = update(context);
+    return generation.current != generation.cleared;
+}
+
+void
+VisualContextReporter::clearDirty(const DocumentContextPtr& context) {
+    auto& generation = update(context);
+    generation.cleared = generation.current;
+}
+
+VisualContextReporterPtr
+VisualContextReporter::create(int fullEvery) {
+    return std::make_shared<VisualContextReporter>(fullEvery);
+}
+
+void
+VisualContextReporter::flatten(const rapidjson::Value& value, const std::string& parent, int index,
+                               EntryMap& entries, rapidjson::Document::AllocatorType& allocator) {
+    if (!value.IsObject())
+        return;
+
+    auto uidMember = value.FindMember("uid");
+    auto uid = uidMember != value.MemberEnd() && uidMember->value.IsString()
+        ? std::string(uidMember->value.GetString(), uidMember->value.GetStringLength())
+        : parent + "/" + std::to_string(index);
+
+    rapidjson::Value node(rapidjson::kObjectType);
+    for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+        if (it->name != CHILDREN)
+            node.AddMember(rapidjson::Value(it->name, allocator), rapidjson::Value(it->value, allocator), allocator);
+    }
+    entries[uid] = Entry{parent, index, std::move(node)};
+
+    auto children = value.FindMember(CHILDREN);
+    if (children != value.MemberEnd() && children->value.IsArray()) {
+        for (rapidjson::SizeType i = 0; i < children->value.Size(); i++)
+            flatten(children->value[i], uid, i, entries, allocator);
+    }
+}
+
+emscripten::val
+VisualContextReporter::report(const DocumentContextPtr& context, int mode) {
+    rapidjson::Document result(rapidjson::kObjectType);
+    auto& allocator = result.GetAllocator();
+
+    auto current = generation(context);
+    if (mHasBase && current == mGeneration) {
+        result.AddMember("type", "unchanged", allocator);
+        result.AddMember("version", mVersion, allocator);
+        return JsonBridge::convert(result, mode);
+    }
+
+    auto document = std::unique_ptr<rapidjson::Document>(new rapidjson::Document(rapidjson::kObjectType));
+    auto visualContext = context->serializeVisualContext(document->GetAllocator());
+    mGeneration = current;
+    EntryMap entries;
+    flatten(visualContext, "", 0, entries, document->GetAllocator());
+
+    mVersion++;
+    bool full = !mHasBase || (mFullEvery > 0 && mDeltaCount >= mFullEvery);
+    result.AddMember("type", rapidjson::StringRef(full ? "full" : "delta"), allocator);
+    result.AddMember("version", mVersion, allocator);
+
+    if (full) {
+        mDeltaCount = 0;
+        result.AddMember("context", rapidjson::Value(visualContext, allocator), allocator);
+    } else {
+        mDeltaCount++;
+        rapidjson::Value added(rapidjson::kArrayType);
+        rapidjson::Value changed(rapidjson::kArrayType);
+        rapidjson::Value removed(rapidjson::kArrayType);
+        for (const auto& entry : entries) {
+            const auto& current = entry.second;
+            auto previous = mBase.find(entry.first);
+            if (previous == mBase.end()) {
+                added.PushBack(toEntryValue(entry.first, current.parent, current.index, current.node, allocator), allocator);
+            } else if (previous->second.parent != current.parent || previous->second.index != current.index ||
+                       previous->second.node != current.node) {
+                changed.PushBack(toEntryValue(entry.first, current.parent, current.index, current.node, allocator), allocator);
+            }
+        }
+        for (const auto& entry : mBase) {
+            if (entries.find(entry.first) == entries.end())
+                removed.PushBack(rapidjson::Value(entry.first.c_str(), entry.first.size(), allocator), allocator);
+        }
+        result.AddMember("base", mVersion - 1, allocator);
+        result.AddMember("added", added, allocator);
+        result.AddMember("removed", removed, allocator);
+        result.AddMember("changed", changed, allocator);
+    }
+
+    // The flattened nodes live in the allocator of the new document
+    mBase = std::move(entries);
+    mBaseDocument = std::move(document);
+    mHasBase = true;
+    return JsonBridge::convert(result, mode);
+}
+
+void
+VisualContextReporter::reset() {
+    mHasBase = false;
+    mBase.clear();
+    mBaseDocument.reset();
+}
+
+EMSCRIPTEN_BINDINGS(apl_wasm_visual_context_reporter) {
+    emscripten::class_<VisualContextReporter>("VisualContextReporter")
+        .smart_ptr<VisualContextReporterPtr>("VisualContextReporterPtr")
+        .class_function("create", &VisualContextReporter::create)
+        .function("report", &VisualContextReporter::report)
+        .function("reset", &VisualContextReporter::reset)
+        .function("getVersion", &VisualContextReporter::getVersion);
+}
+
+} // namespace wasm
+} // namespace apl
@@ -8,14 +8,10 @@
 namespace apl {
 namespace wasm {
 
-    float
-    WASMMetrics::toViewhost(float value) const {
-        return value * getScaleToViewhost() * getDpi() / 160.0f;
-    }
-
-    float
-    WASMMetrics::toCore(float value) const {
-        return value * getScaleToCore() * 160.0f / getDpi();
+    void
+    WASMMetrics::computeScale() {
+        mViewhostScale = getScaleToViewhost() * getDpi() / 160.0f;
+        mCoreScale = getScaleToCore() * 160.0f / getDpi();
     }
 
     float
@@ -0,0 +1,52 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Build the binary snapshot of a package or document.
+ *
+ *   apl-snapshot <input.json> <output> [name:version]
+ *
+ * The reference is recorded in the snapshot, so the viewhost rejects it for any other package.
+ */
+
+#include "wasm/jsonsnapshot.h"
+#include <rapidjson/error/en.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+int
+main(int argc, char** argv) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <input.json> <output> [name:version]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        std::cerr << "Unable to read " << argv[1] << std::endl;
+        return 1;
+    }
+    std::string json((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    rapidjson::Document document;
+    document.Parse(json.c_str(), json.size());
+    if (document.HasParseError()) {
+        std::cerr << argv[1] << ":" << document.GetErrorOffset() << ": "
+                  << rapidjson::GetParseError_En(document.GetParseError()) << std::endl;
+        return 1;
+    }
+
+    auto image = apl::wasm::JsonSnapshot::encode(document, argc == 4 ? argv[3] : "");
+    std::ofstream output(argv[2], std::ios::binary);
+    output.write(reinterpret_cast<const char*>(image.data()), image.size());
+    if (!output) {
+        std::cerr << "Unable to write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << argv[2] << ": " << json.size() << " bytes of JSON, " << image.size() << " bytes of snapshot" << std::endl;
+    return 0;
+}